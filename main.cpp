@@ -1,54 +1,93 @@
 #include <iostream>
-
-#include <thread>
-#include <chrono>
+#include <cstring>
 
 #include "src/consts.h"
 
 #include "src/contra/game.h"
 #include "src/kernel/avancezlib.h"
+#include "src/kernel/frame_pacer.h"
 
 float game_speed = 1.f;
+const float HEADLESS_TIME_STEP = 1.f / 60.f;
+const int DEFAULT_TARGET_FPS = 60;
 
 int main (int argc, char *argv[]) {
     AvancezLib engine{};
 
-    engine.init(WINDOW_WIDTH, WINDOW_HEIGHT);
+    AvancezLib::RenderSettings settings;
+    settings.pixelsZoom = PIXELS_ZOOM;
+    // Number of frames to run before quitting, 0 to run until the game is closed
+    int max_frames = 0;
+    // Frames per second the loop is paced to, 0 to use the refresh rate of the display
+    int target_fps = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc)
+            settings.windowScale = atoi(argv[++i]); // Window size in times the native resolution
+        else if (strcmp(argv[i], "--serial-render") == 0)
+            settings.threaded = false; // Renders the frames in the main thread instead of a render thread
+        else if (strcmp(argv[i], "--headless") == 0)
+            settings.headless = true; // Software rendering without window, with a fixed time step
+        else if (strcmp(argv[i], "--frame-hashes") == 0 && i + 1 < argc)
+            settings.frameHashLog = argv[++i];
+        else if (strcmp(argv[i], "--dump-frames") == 0 && i + 1 < argc)
+            settings.frameDumpFolder = argv[++i];
+        else if (strcmp(argv[i], "--capture-folder") == 0 && i + 1 < argc)
+            settings.captureFolder = argv[++i]; // Frames are saved there while capturing, F12 toggles it
+        else if (strcmp(argv[i], "--capture-yuv") == 0)
+            settings.captureFormat = FrameCapture::YUV;
+        else if (strcmp(argv[i], "--capture") == 0)
+            settings.captureOnStart = true;
+        else if (strcmp(argv[i], "--debug-draw") == 0 && i + 1 < argc)
+            settings.debugDraw = (Uint8) strtol(argv[++i], nullptr, 0); // Mask of DebugDraw categories shown
+        else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+            settings.jobWorkers = atoi(argv[++i]); // Worker threads, 0 runs the jobs serially for replays
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            target_fps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            max_frames = atoi(argv[++i]);
+    }
+
+    if (!engine.init(WINDOW_WIDTH, WINDOW_HEIGHT, settings)) {
+        return 1;
+    }
 
     Game game;
     game.Create(&engine);
     game.Init();
 
-    float lastTime = engine.getElapsedTime();
-#ifndef NDEBUG
+    if (target_fps <= 0)
+        target_fps = engine.getDisplayRefreshRate();
+    if (target_fps <= 0)
+        target_fps = DEFAULT_TARGET_FPS;
+    FramePacer pacer;
+    // Headless runs as fast as possible, it only measures the frames
+    pacer.Create(settings.headless ? 0 : target_fps);
+
     char fps[100];
-#endif
-    float smoothedDt = 0.004;
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wmissing-noreturn"
+    int frames = 0;
     while (true) {
-        float newTime = engine.getElapsedTime();
-        float dt = newTime - lastTime;
-
-        // Cap to 240 FPS, because my laptop goes very noisy otherwise and it embarrasses me
-        int dtMillis = (int) (dt * 1000.f);
-        if (dtMillis < 4) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(4 - dtMillis));
-            newTime = engine.getElapsedTime();
-            dt = newTime - lastTime;
-            smoothedDt = smoothedDt * 0.99f + dt * 0.01f;
+        float dt = pacer.Wait();
+        if (settings.headless) {
+            // Fixed time step, so every run renders exactly the same frames
+            dt = HEADLESS_TIME_STEP;
         }
 
         dt = dt * game_speed;
-        lastTime = newTime;
 
         engine.processInput();
         game.Update(dt);
-#ifndef NDEBUG
-        sprintf(fps, "FPS: %d", (int) round(1 / smoothedDt));
-        engine.drawText(0, 0, fps);
-#endif
+        if (!settings.headless && engine.isDebugEnabled(DebugDraw::DEBUG_STATS)) {
+            sprintf(fps, "FPS: %d P50 %.1fms P99 %.1fms", (int) round(1 / SDL_max(pacer.GetAverage(), 0.001f)),
+                    pacer.GetPercentile(50) * 1000.f, pacer.GetPercentile(99) * 1000.f);
+            engine.debugText(DebugDraw::DEBUG_STATS, 0, 0, fps);
+        }
         game.Draw();
+
+        if (max_frames > 0 && ++frames >= max_frames) {
+            engine.quit();
+        }
     }
 #pragma clang diagnostic pop
 }
@@ -8,16 +8,11 @@
 void BoxCollider::GetOccupiedCells(Grid::CellsSquare &square) {
     auto *grid = scene->GetGrid();
     int cell_size = grid->getCellSize();
-    int row_size = grid->getRowSize();
-    int col_size = grid->getColSize();
-    square.min_cell_x = std::min(std::max((int) floor((go->position.x + m_box.top_left_x) / cell_size), 0),
-            row_size - 1);
-    square.max_cell_x = std::min(std::max((int) floor((go->position.x + m_box.bottom_right_x) / cell_size), 0),
-            row_size - 1);
-    square.min_cell_y = std::min(std::max((int) floor((go->position.y + m_box.top_left_y) / cell_size), 0),
-            col_size - 1);
-    square.max_cell_y = std::min(std::max((int) floor((go->position.y + m_box.bottom_right_y) / cell_size), 0),
-            col_size - 1);
+    square.min_cell_x = (int) floor((go->position.x + m_box.top_left_x) / cell_size);
+    square.max_cell_x = (int) floor((go->position.x + m_box.bottom_right_x) / cell_size);
+    square.min_cell_y = (int) floor((go->position.y + m_box.top_left_y) / cell_size);
+    square.max_cell_y = (int) floor((go->position.y + m_box.bottom_right_y) / cell_size);
+    grid->Clip(square);
 }
 
 bool BoxCollider::IsColliding(const CollideComponent *other) {
@@ -39,12 +34,10 @@ bool BoxCollider::IsColliding(const CollideComponent *other) {
 
 void BoxCollider::Update(float dt) {
     CollideComponent::Update(dt);
-#ifndef NDEBUG
-    if (!m_disabled) {
-        scene->GetEngine()->strokeSquare(
+    if (!m_disabled && scene->GetEngine()->isDebugEnabled(DebugDraw::DEBUG_COLLIDERS)) {
+        scene->GetEngine()->debugStrokeSquare(DebugDraw::DEBUG_COLLIDERS,
                 AbsoluteTopLeftX() - scene->GetCameraX(), AbsoluteTopLeftY(),
                 AbsoluteBottomRightX() - scene->GetCameraX(), AbsoluteBottomRightY(),
-                {0, 0, 255});
+                {0, 0, 255, 255});
     }
-#endif
 }
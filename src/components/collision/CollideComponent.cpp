@@ -68,6 +68,14 @@ void CollideComponent::OnGameObjectDisabled() {
     }
 }
 
+void CollideComponent::OnGameObjectAsleep() {
+    // Out of the broadphase while sleeping, the cells it left may be reused by the grid for other places
+    if (m_layer >= 0) {
+        scene->GetGrid()->Remove(this);
+        is_occupying = {0, -1, 0, -1};
+    }
+}
+
 void CollideComponent::Disable() {
     if (!m_disabled) {
         if (m_layer >= 0) {
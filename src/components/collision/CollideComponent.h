@@ -18,7 +18,7 @@ public:
 
 class CollideComponent : public Component {
 protected:
-    Grid::CellsSquare is_occupying;
+    Grid::CellsSquare is_occupying{0, -1, 0, -1}; // None until first updated
     int m_layer, m_checkLayer;
     CollideComponentListener *listener = nullptr;
     bool m_disabled;
@@ -41,6 +41,8 @@ public:
 
     void OnGameObjectDisabled() override;
 
+    void OnGameObjectAsleep() override;
+
     void Disable();
 
     void Enable();
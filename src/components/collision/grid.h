@@ -32,6 +32,15 @@ public:
         }
     }
 
+    // Colliders in all the layers of the cell
+    [[nodiscard]] size_t Count() const {
+        size_t count = 0;
+        for (const auto &layer : colliders) {
+            count += layer.size();
+        }
+        return count;
+    }
+
     void Remove(CollideComponent *collider, int layer) {
         if (layer < GRID_CELL_LAYERS && layer >= 0) {
             for (int i = 0; i < colliders[layer].size(); i++) {
@@ -43,21 +52,39 @@ public:
     }
 };
 
+/**
+ * Cells of the colliders of a scene. The grid covers a window of columns which wraps around, so it can
+ * follow the camera over a level of any length: the columns a whole window apart share the cells, which
+ * only costs some extra checks between colliders far apart.
+ */
 class Grid {
 private:
     std::vector<GridCell> cells;
     std::unordered_map<CollideComponent *, std::unordered_map<CollideComponent *, bool>> collision_cache;
-    int cell_size;
-    int row_size;
-    int col_size;
+    int cell_size = 1;
+    int row_size = 0;
+    int col_size = 0;
 public:
     struct CellsSquare {
         int min_cell_x, max_cell_x;
         int min_cell_y, max_cell_y;
     };
 
+    /**
+     * @param x Column in the whole level, wrapped to the columns of the grid
+     */
     GridCell *GetCell(int x, int y) {
-        return &cells[y * row_size + x];
+        x %= row_size;
+        return &cells[y * row_size + (x < 0 ? x + row_size : x)];
+    }
+
+    /**
+     * Limits the cells to the rows of the grid, and the columns to a single pass over the grid
+     */
+    void Clip(CellsSquare &square) const {
+        square.min_cell_y = std::min(std::max(square.min_cell_y, 0), col_size - 1);
+        square.max_cell_y = std::min(std::max(square.max_cell_y, 0), col_size - 1);
+        square.max_cell_x = std::min(square.max_cell_x, square.min_cell_x + row_size - 1);
     }
 
     /**
@@ -3,125 +3,141 @@
 //
 
 #include "AnimationRenderer.h"
+#include "AnimationSet.h"
 #include "../../kernel/game_object.h"
 #include "../scene.h"
 #include "../../consts.h"
 
 void AnimationRenderer::Update(float dt) {
-    if (!go->IsEnabled() || !enabled || !sprite || !m_currentAnimation)
+    if (!go->IsEnabled() || !enabled || !sprite || m_current < 0)
         return;
 
+    const AnimationSet::FrameTable &table = m_set->Get(m_current);
     if (playing) {
-        m_currentTime += m_goingForward ? dt : -dt;
-    }
-
-    // Check if it is over the top or bellow zero to loop the animation
-    float animation_duration = (float) m_currentAnimation->frames * m_currentAnimation->speed;
-    while (m_currentTime > animation_duration || m_currentTime < 0) {
-        if (m_currentAnimation->stop == DONT_STOP) {
-            float modulo = abs(fmod(m_currentTime, animation_duration));
-            if (m_goingForward) {
-                m_currentTime = modulo;
-            } else {
-                m_currentTime = animation_duration - modulo;
-            }
-        } else if (m_currentAnimation->stop == BOUNCE || m_currentAnimation->stop == BOUNCE_AND_STOP) {
-            if (!m_goingForward && m_currentAnimation->stop == BOUNCE_AND_STOP) {
-                Pause();
-                m_currentTime = 0;
+        const float speed = table.animation.speed;
+        m_frameTime += m_goingForward ? dt : -dt;
+        while (playing) {
+            if (m_goingForward && m_frameTime >= speed) {
+                m_frameTime -= speed;
+                StepFrame();
+            } else if (!m_goingForward && m_frameTime < 0) {
+                m_frameTime += speed;
+                StepFrame();
             } else {
-                float modulo = fmod(m_currentTime, animation_duration);
-                m_currentTime = m_currentTime < 0
-                                ? -modulo + m_currentAnimation->speed // We add speed to avoid repeating frame 0
-                                : animation_duration - modulo -
-                                  m_currentAnimation->speed; // We subtract speed to avoid repeating last frame
-                m_goingForward = !m_goingForward;
-            }
-        } else { // Stop and last or stop and first
-            Pause();
-            float last = (float) animation_duration - m_currentAnimation->speed;
-            if (m_currentAnimation->stop == STOP_AND_FIRST) {
-                m_currentTime = m_goingForward ? 0 : last;
-            } else {
-                m_currentTime = m_goingForward ? last : 0;
+                break;
             }
         }
     }
-    int frame = floor(m_currentTime / m_currentAnimation->speed);
-    // Flip the anchor shift in x if we are mirroring horizontally (so the shift is correct)
-    int x_shift = (mirrorHorizontal
-                   ? m_currentAnimation->frame_w - m_currentAnimation->anchor_x
-                   : m_currentAnimation->anchor_x
-                  ) * PIXELS_ZOOM;
+
+    const SDL_Rect &src = table.src[m_frame];
     sprite->draw(
-            int(round(go->position.x - scene->GetCameraX())) - x_shift,
-            int(round(go->position.y - scene->GetCameraY())) - m_currentAnimation->anchor_y * PIXELS_ZOOM,
-            m_currentAnimation->frame_w * PIXELS_ZOOM, m_currentAnimation->frame_h * PIXELS_ZOOM,
-            m_currentAnimation->start_x + frame * m_currentAnimation->frame_w,
-            m_currentAnimation->start_y,
-            m_currentAnimation->frame_w, m_currentAnimation->frame_h,
+            int(round(go->position.x - scene->GetCameraX())) - table.shift_x[mirrorHorizontal ? 1 : 0],
+            int(round(go->position.y - scene->GetCameraY())) - table.shift_y,
+            table.dst_w, table.dst_h,
+            src.x, src.y, src.w, src.h,
             mirrorHorizontal
     );
-#ifndef NDEBUG
-    scene->GetEngine()->fillSquare(round(go->position.x - scene->GetCameraX()),
-            round(go->position.y - scene->GetCameraY()), PIXELS_ZOOM, {255, 0, 0});
-#endif
+    scene->GetEngine()->debugFillSquare(DebugDraw::DEBUG_ANCHORS, round(go->position.x - scene->GetCameraX()),
+            round(go->position.y - scene->GetCameraY()), PIXELS_ZOOM, {255, 0, 0, 255});
+}
+
+void AnimationRenderer::Reset() {
+    m_frame = 0;
+    m_frameTime = 0;
+    m_goingForward = true;
+    playing = m_current >= 0;
+}
+
+void AnimationRenderer::StepFrame() {
+    const AnimationSet::FrameTable &table = m_set->Get(m_current);
+    const int next = m_frame + (m_goingForward ? 1 : -1);
+    if (next >= 0 && next < table.animation.frames) {
+        m_frame = short(next);
+        return;
+    }
+    const AnimationSet::EndTransition &end = table.ends[m_goingForward ? 0 : 1];
+    m_frame = end.frame;
+    if (end.pause) {
+        Pause();
+        m_frameTime = 0;
+    } else if (end.reverse) {
+        m_goingForward = !m_goingForward;
+        // Keep the same time inside the frame, measured in the new direction
+        m_frameTime = table.animation.speed - m_frameTime;
+    }
 }
 
-int AnimationRenderer::AddAnimation(AnimationRenderer::Animation animation) {
-    long saved_index = -1;
-    if (m_currentAnimation) {
-        saved_index = m_currentAnimation - &m_animations[0];
+int AnimationRenderer::AddAnimation(const AnimationRenderer::Animation &animation) {
+    if (!m_ownSet) {
+        auto set = m_set ? std::make_shared<AnimationSet>(*m_set) : std::make_shared<AnimationSet>();
+        m_ownSet = set.get();
+        m_set = std::move(set);
     }
-    m_animations.push_back(animation);
-    if (saved_index < 0) {
-        m_currentAnimation = &m_animations[0];
-    } else {
-        m_currentAnimation = &m_animations[saved_index];
+    int index = m_ownSet->Add(animation);
+    if (m_current < 0) {
+        m_current = 0;
     }
-    return (int) m_animations.size() - 1;
+    return index;
+}
+
+void AnimationRenderer::SetAnimationSet(std::shared_ptr<const AnimationSet> set) {
+    m_set = std::move(set);
+    m_ownSet = nullptr;
+    m_current = m_set && m_set->Count() > 0 ? 0 : -1;
+    m_frame = 0;
+    m_frameTime = 0;
+}
+
+AnimationRenderer::Animation AnimationRenderer::GetAnimation(int index) const {
+    if (index < 0 || index >= GetAnimationsCount()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                "AnimationRenderer::GetAnimation: Invalid animation %d", index);
+        return {};
+    }
+    return m_set->Get(index).animation;
+}
+
+int AnimationRenderer::GetAnimationsCount() const {
+    return m_set ? m_set->Count() : 0;
 }
 
 void AnimationRenderer::CurrentAndPause(int index, bool forward) {
-    if (index < 0 || index >= m_animations.size()) {
+    if (index < 0 || index >= GetAnimationsCount()) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                 "AnimationRenderer::PlayAnimation: Invalid animation %d", index);
         return;
     }
     if (!IsCurrent(index)) {
-        m_currentAnimation = &m_animations[index];
-        m_currentTime = 0.f;
-        m_currentTime = forward ? 0.f : (float) m_currentAnimation->frames * m_currentAnimation->speed;
+        m_current = index;
+        m_frame = forward ? 0 : short(m_set->Get(index).animation.frames - 1);
+        m_frameTime = forward ? 0.f : m_set->Get(index).animation.speed;
         Pause();
     }
 }
 
 void AnimationRenderer::PlayAnimation(int index, bool forward, int frame) {
-    if (index < 0 || index >= m_animations.size()) {
+    if (index < 0 || index >= GetAnimationsCount()) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                 "AnimationRenderer::PlayAnimation: Invalid animation %d", index);
         return;
     }
     if (!IsCurrent(index)) {
-        m_currentAnimation = &m_animations[index];
-        // In case frame is -1
-        m_currentTime = forward ? 0.f : (float) m_currentAnimation->frames * m_currentAnimation->speed;
+        m_current = index;
+        // In case frame is -1, start from the end going backwards
+        m_frame = forward ? 0 : short(m_set->Get(index).animation.frames - 1);
+        m_frameTime = forward ? 0.f : m_set->Get(index).animation.speed;
     }
     Play(frame, forward);
 }
 
-int AnimationRenderer::FindAnimation(std::string name) const {
-    for (int i = 0; i < m_animations.size(); i++) {
-        if (m_animations[i].name == name) {
-            return i;
-        }
-    }
-    return -1;
+int AnimationRenderer::FindAnimation(Uint32 id) const {
+    return m_set ? m_set->Find(id) : -1;
 }
 
 void AnimationRenderer::Stop() {
     Pause();
-    m_currentTime = 0;
+    m_frame = 0;
+    m_frameTime = 0;
 }
 
 void AnimationRenderer::Play(int frame, bool forward) {
@@ -135,12 +151,12 @@ void AnimationRenderer::Pause() {
 }
 
 AnimationRenderer::Animation AnimationRenderer::GetCurrentAnimation() const {
-    return *m_currentAnimation;
+    return m_set->Get(m_current).animation;
 }
 
 void AnimationRenderer::GoToFrame(int frame) {
-    if (frame >= 0) {
-        m_currentTime = (float) (frame % m_currentAnimation->frames) * m_currentAnimation->speed;
+    if (frame >= 0 && m_current >= 0) {
+        m_frame = short(frame % m_set->Get(m_current).animation.frames);
+        m_frameTime = 0;
     }
 }
-
@@ -6,12 +6,26 @@
 #define CONTRA_ANIMATIONRENDERER_H
 
 
+#include <memory>
 #include "RenderComponent.h"
 
+class AnimationSet;
+
+/** FNV-1a hash of an animation name, computed at compile time for literals */
+constexpr Uint32 AnimationId(const char *name) {
+    Uint32 hash = 2166136261u;
+    for (; *name; name++) {
+        hash ^= (unsigned char) *name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 /**
  * Component that allows to render animations from a single spritesheet.
  * The component expects the frames of each animation to be horizontal,
  * contiguous and have fixed size.
+ * The animations live in an AnimationSet that can be shared by many renderers.
  */
 class AnimationRenderer : public RenderComponent {
 public:
@@ -42,12 +56,13 @@ public:
         AnimationStop stop;
     };
 
-    // Adds an animation to the renderer and returns the index
-    int AddAnimation(Animation animation);
+    // Adds an animation to the renderer and returns the index, a shared set is copied first
+    int AddAnimation(const Animation &animation);
 
-    [[nodiscard]] Animation GetAnimation(int index) const {
-        return m_animations.at(index);
-    }
+    /** Uses the given shared animations, replacing the current ones */
+    void SetAnimationSet(std::shared_ptr<const AnimationSet> set);
+
+    [[nodiscard]] Animation GetAnimation(int index) const;
 
     /** Plays the indicated animation */
     void PlayAnimation(int index, bool forward = true, int frame = -1);
@@ -69,8 +84,13 @@ public:
 
     [[nodiscard]] Animation GetCurrentAnimation() const;
 
+    /** Find an animation by id (see AnimationId), -1 indicates the animation was not found */
+    [[nodiscard]] int FindAnimation(Uint32 id) const;
+
     /** Find an animation by name, -1 indicates the animation was not found */
-    [[nodiscard]] int FindAnimation(std::string name) const;
+    [[nodiscard]] int FindAnimation(const std::string &name) const {
+        return FindAnimation(AnimationId(name.c_str()));
+    }
 
     /** Indicates if the renderer is playing an animation */
     bool IsPlaying() { return playing; }
@@ -80,7 +100,7 @@ public:
 
     /** Indicates if the animation is the currently selected */
     inline bool IsCurrent(int animationIndex) {
-        return m_currentAnimation == &m_animations[animationIndex];
+        return m_current == animationIndex;
     }
 
     /** Moves the current time to the start of the specified frame */
@@ -90,12 +110,22 @@ public:
 
     void Update(float dt) override;
 
-    [[nodiscard]] int GetAnimationsCount() { return m_animations.size(); }
+    /** Rewinds the current animation and plays it, as it is after being created */
+    void Reset() override;
+
+    [[nodiscard]] int GetAnimationsCount() const;
 
 private:
-    std::vector<AnimationRenderer::Animation> m_animations;
-    Animation *m_currentAnimation = nullptr;
-    float m_currentTime;
+    /** Moves the cursor to the next frame in the current direction */
+    void StepFrame();
+
+    std::shared_ptr<const AnimationSet> m_set;
+    /** Set created by this renderer, the only one AddAnimation can modify */
+    AnimationSet *m_ownSet = nullptr;
+    int m_current = -1;
+    short m_frame = 0;
+    /** Time elapsed in the current frame, it runs backwards when the animation does */
+    float m_frameTime = 0.f;
     bool playing;
     /** Determines the direction of the animation, if it is false time goes backwards */
     bool m_goingForward = true;
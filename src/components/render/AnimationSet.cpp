@@ -0,0 +1,50 @@
+#include "AnimationSet.h"
+#include "../../consts.h"
+
+int AnimationSet::Add(const AnimationRenderer::Animation &animation) {
+    FrameTable table;
+    table.animation = animation;
+    table.id = AnimationId(animation.name.c_str());
+    const short frames = SDL_max(animation.frames, 1);
+    const short last = short(frames - 1);
+    table.animation.frames = frames;
+    for (int i = 0; i < frames; i++) {
+        table.src.push_back({animation.start_x + i * animation.frame_w, animation.start_y,
+                             animation.frame_w, animation.frame_h});
+    }
+    // Flip the anchor shift in x if we are mirroring horizontally (so the shift is correct)
+    table.shift_x[0] = animation.anchor_x * PIXELS_ZOOM;
+    table.shift_x[1] = (animation.frame_w - animation.anchor_x) * PIXELS_ZOOM;
+    table.shift_y = animation.anchor_y * PIXELS_ZOOM;
+    table.dst_w = animation.frame_w * PIXELS_ZOOM;
+    table.dst_h = animation.frame_h * PIXELS_ZOOM;
+
+    // Bouncing does not repeat the first and last frames
+    const short before_last = short(SDL_max(frames - 2, 0));
+    const short second = short(SDL_min(1, last));
+    switch (animation.stop) {
+        case AnimationRenderer::DONT_STOP:
+            table.ends[0] = {0, false, false};
+            table.ends[1] = {last, false, false};
+            break;
+        case AnimationRenderer::BOUNCE:
+            table.ends[0] = {before_last, true, false};
+            table.ends[1] = {second, true, false};
+            break;
+        case AnimationRenderer::BOUNCE_AND_STOP:
+            table.ends[0] = {before_last, true, false};
+            table.ends[1] = {0, false, true};
+            break;
+        case AnimationRenderer::STOP_AND_FIRST:
+            table.ends[0] = {0, false, true};
+            table.ends[1] = {last, false, true};
+            break;
+        case AnimationRenderer::STOP_AND_LAST:
+            table.ends[0] = {last, false, true};
+            table.ends[1] = {0, false, true};
+            break;
+    }
+
+    m_tables.push_back(std::move(table));
+    return (int) m_tables.size() - 1;
+}
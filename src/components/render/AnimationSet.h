@@ -0,0 +1,63 @@
+#ifndef CONTRA_ANIMATIONSET_H
+#define CONTRA_ANIMATIONSET_H
+
+#include <SDL.h>
+#include <vector>
+#include "AnimationRenderer.h"
+
+/**
+ * Immutable list of compiled animations, shared (reference counted) between all the renderers
+ * drawing the same kind of object, like the bullets of a pool. The renderers only keep their
+ * own playback state.
+ */
+class AnimationSet {
+public:
+    /** What happens when the frame cursor goes past the end of the animation */
+    struct EndTransition {
+        short frame; // Frame to continue from
+        bool reverse; // Change the direction of the animation
+        bool pause; // Pause the animation at the frame
+    };
+
+    /** Animation compiled when added, so playing it only moves an integer frame cursor */
+    struct FrameTable {
+        AnimationRenderer::Animation animation;
+        /** Hash of the animation name */
+        Uint32 id;
+        /** Source rect of each frame inside the sprite */
+        std::vector<SDL_Rect> src;
+        /** Anchor shift from the object position, zoomed, in x for not mirrored [0] and mirrored [1] */
+        int shift_x[2];
+        int shift_y;
+        /** Zoomed size of the frames */
+        int dst_w, dst_h;
+        /** Transitions after the last frame going forward [0] and after the first going backwards [1] */
+        EndTransition ends[2];
+    };
+
+    /** Compiles the animation and returns its index */
+    int Add(const AnimationRenderer::Animation &animation);
+
+    /** Index of the animation with the given id (see AnimationId), -1 if not found */
+    [[nodiscard]] int Find(Uint32 id) const {
+        for (int i = 0; i < (int) m_tables.size(); i++) {
+            if (m_tables[i].id == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    [[nodiscard]] const FrameTable &Get(int index) const {
+        return m_tables[index];
+    }
+
+    [[nodiscard]] int Count() const {
+        return (int) m_tables.size();
+    }
+
+private:
+    std::vector<FrameTable> m_tables;
+};
+
+#endif //CONTRA_ANIMATIONSET_H
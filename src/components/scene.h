@@ -9,47 +9,61 @@
 #include <queue>
 #include "../kernel/game_object.h"
 #include "../kernel/avancezlib.h"
+#include "../kernel/tile_map.h"
+#include "../kernel/timer_wheel.h"
 #include "../consts.h"
 #include "collision/grid.h"
+#include "scene_layer.h"
+#include "scene_activity.h"
 
 class BaseScene : public GameObject {
 protected:
     std::queue<std::pair<GameObject *, int>> game_objects_to_add;
-    std::unique_ptr<Sprite> m_background;
+    std::shared_ptr<Sprite> m_background;
+    std::unique_ptr<TileMap> m_backgroundTiles;
     AvancezLib *m_engine;
     Vector2D m_camera;
-    std::set<GameObject *> *game_objects[RENDERING_LAYERS];
+    /**
+     * Where the space of the objects starts in the background. Scenes keeping their objects local to the
+     * current screen move it to change screen instead of moving the objects, the camera is in that space too.
+     */
+    Vector2D m_origin;
+    SceneLayer game_objects[RENDERING_LAYERS];
     Grid m_grid;
+    SceneActivity m_activity;
+    TimerWheel m_timers;
     Vector2D m_animationShift;
     float m_time = 0.f;
     float m_animationShiftTime;
-    std::unique_ptr<Music> m_music;
+    std::shared_ptr<Music> m_music;
 public:
-    BaseScene() {
-        for (int i = 0; i < RENDERING_LAYERS; i++) {
-            game_objects[i] = new std::set<GameObject *>();
-        }
-    }
-
-    ~BaseScene() {
-        for (int i = 0; i < RENDERING_LAYERS; i++) {
-            delete game_objects[i];
-        }
-    }
-
+    /**
+     * @param background_tiles_path Path without extension of the .tiles map and tileset generated by the
+     * tile converter. If they can be loaded the background is drawn by tiles, if not the background_path
+     * image is used as it is.
+     */
     void Create(AvancezLib *engine, const char *background_path, const char *music_path = nullptr,
-                const Vector2D anim_shift = Vector2D(0, 0), const float anim_shift_time = 0.2f) {
+                const Vector2D anim_shift = Vector2D(0, 0), const float anim_shift_time = 0.2f,
+                const char *background_tiles_path = nullptr) {
         GameObject::Create();
         m_engine = engine;
         m_animationShift = anim_shift;
         m_animationShiftTime = anim_shift_time;
-        if (background_path != nullptr) {
-            m_background.reset(m_engine->createSprite(background_path));
+        if (background_tiles_path != nullptr) {
+            m_backgroundTiles = std::make_unique<TileMap>();
+            if (!m_backgroundTiles->Load(m_engine, (std::string(background_tiles_path) + ".tiles").c_str(),
+                                         (std::string(background_tiles_path) + ".png").c_str())) {
+                m_backgroundTiles.reset();
+            }
+        }
+        if (background_path != nullptr && !m_backgroundTiles) {
+            m_background = m_engine->getAssets().GetSprite(background_path);
         }
         if (music_path != nullptr) {
-            m_music.reset(m_engine->createMusic(music_path));
+            m_music = m_engine->getAssets().GetMusic(music_path);
         }
         m_camera = Vector2D(0, 0);
+        m_origin = Vector2D(0, 0);
     }
 
     void Update(float dt) override {
@@ -57,62 +71,78 @@ public:
 
         m_time += dt;
 
-        if (m_background) {
-            // Draw background (smoothing the zoom)
-            int camera_without_zoom_x = int(floorf(m_camera.x / PIXELS_ZOOM));
-            int shift_x = -int(roundf(m_camera.x - camera_without_zoom_x * PIXELS_ZOOM));
-            if (camera_without_zoom_x < 0) {
-                shift_x -= camera_without_zoom_x * PIXELS_ZOOM;
-                camera_without_zoom_x = 0;
-            }
-            int camera_without_zoom_y = int(floorf(m_camera.y / PIXELS_ZOOM));
-            int shift_y = -int(roundf(m_camera.y - camera_without_zoom_y * PIXELS_ZOOM));
-
+        const Vector2D background_camera = m_origin + m_camera;
+        if (m_backgroundTiles) {
             bool use_animation_shift = fmod(m_time, 2 * m_animationShiftTime) < m_animationShiftTime;
-
-            // We need to add an extra pixel if we shift slightly bc if not we will have black pixels
-            // the reason why we don't do it ALWAYS is because if the background image has
-            // the exact same height as the window (scaled by PIXELS_ZOOM), trying to get 1px more
-            // will deform the image, this is not necessary if there is no shifting so we just avoid it.
-            m_background->draw(shift_x, shift_y,
-                    WINDOW_WIDTH + (shift_x == 0 ? 0 : PIXELS_ZOOM),
-                    WINDOW_HEIGHT + (shift_y == 0 ? 0 : PIXELS_ZOOM),
-                    camera_without_zoom_x + (use_animation_shift ? m_animationShift.x : 0),
-                    camera_without_zoom_y + (use_animation_shift ? m_animationShift.y : 0),
-                    WINDOW_WIDTH / PIXELS_ZOOM + (shift_x == 0 ? 0 : 1),
-                    WINDOW_HEIGHT / PIXELS_ZOOM + (shift_y == 0 ? 0 : 1));
+            m_backgroundTiles->Draw(background_camera.x, background_camera.y, use_animation_shift ? 1 : 0,
+                                    PIXELS_ZOOM, WINDOW_WIDTH, WINDOW_HEIGHT);
+        } else if (m_background) {
+            // The frame is rendered at native resolution, the background only has to follow the camera
+            bool use_animation_shift = fmod(m_time, 2 * m_animationShiftTime) < m_animationShiftTime;
+            int width = m_background->getWidth() - int(m_animationShift.x);
+            int height = m_background->getHeight() - int(m_animationShift.y);
+            m_background->draw(-int(roundf(background_camera.x)), -int(roundf(background_camera.y)),
+                    width * PIXELS_ZOOM, height * PIXELS_ZOOM,
+                    use_animation_shift ? int(m_animationShift.x) : 0,
+                    use_animation_shift ? int(m_animationShift.y) : 0,
+                    width, height);
         }
 
         m_grid.ClearCollisionCache(); // Clear collision cache
-        for (auto *layer = game_objects; layer != game_objects + RENDERING_LAYERS; layer++) {
-            // Update objects which are enabled and not to be removed
-            for (auto *game_object : **layer)
-                if (game_object->IsEnabled() && !game_object->IsMarkedToRemove())
-                    game_object->Update(dt);
+        // Before the objects, so the ones woken up by their timers react in the same frame
+        m_timers.Advance(dt);
+        m_activity.BeginFrame(m_camera);
+        for (auto &layer : game_objects) {
+            // Update objects which are enabled, not to be removed and awake, in the order they were added
+            for (auto *game_object : layer) {
+                float object_dt;
+                if (game_object->IsEnabled() && !game_object->IsMarkedToRemove()
+                    && m_activity.ShouldUpdate(game_object, dt, object_dt))
+                    game_object->Update(object_dt);
+            }
         }
-        // Delete objects marked to remove
-        for (auto *layer = game_objects; layer != game_objects + RENDERING_LAYERS; layer++) {
-            std::set<GameObject *>::iterator it = (*layer)->begin();
-            while (it != (*layer)->end()) {
-                auto *game_object = *it;
-                if (game_object->IsMarkedToRemove()) {
-                    it = (*layer)->erase(it);
-                    game_object->UnmarkToRemove();
-                    if (game_object->onRemoval == DESTROY) {
-                        game_object->Destroy();
-                    }
-                } else {
-                    it++;
+        // Delete objects marked to remove and close the gaps left by the removed ones
+        for (auto &layer : game_objects) {
+            layer.Compact([](GameObject *game_object) {
+                if (game_object->onRemoval == DESTROY) {
+                    game_object->Destroy();
                 }
-            }
+            });
         }
         // Add new ones
         while (!game_objects_to_add.empty()) {
             std::pair<GameObject *, int> next = game_objects_to_add.front();
             game_objects_to_add.pop();
-            game_objects[next.second]->insert(next.first);
+            game_objects[next.second].Insert(next.first);
         }
 
+        if (m_engine->isDebugEnabled(DebugDraw::DEBUG_GRID)) {
+            DrawGridOccupancy();
+        }
+    }
+
+    /** Debug overlay of the visible grid cells with colliders, coloured by how many they have */
+    void DrawGridOccupancy() {
+        const int cell_size = m_grid.getCellSize();
+        const int min_x = int(floorf(m_camera.x / cell_size));
+        const int max_x = SDL_min(min_x + m_grid.getRowSize() - 1, int(m_camera.x + WINDOW_WIDTH) / cell_size);
+        const int min_y = SDL_max(0, int(m_camera.y) / cell_size);
+        const int max_y = SDL_min(m_grid.getColSize() - 1, int(m_camera.y + WINDOW_HEIGHT) / cell_size);
+        char count_text[8];
+        for (int y = min_y; y <= max_y; y++) {
+            for (int x = min_x; x <= max_x; x++) {
+                size_t count = m_grid.GetCell(x, y)->Count();
+                if (count == 0)
+                    continue;
+                SDL_Color color = count == 1 ? SDL_Color{0, 255, 0, 255} : count < 4 ? SDL_Color{255, 255, 0, 255}
+                                                                                     : SDL_Color{255, 0, 0, 255};
+                int left = x * cell_size - int(m_camera.x), top = y * cell_size - int(m_camera.y);
+                m_engine->debugStrokeSquare(DebugDraw::DEBUG_GRID, left, top, left + cell_size, top + cell_size,
+                                            color);
+                snprintf(count_text, sizeof(count_text), "%d", (int) count);
+                m_engine->debugText(DebugDraw::DEBUG_GRID, left + PIXELS_ZOOM, top + PIXELS_ZOOM, count_text, color);
+            }
+        }
     }
 
     void FadeOutMusic(int ms = 1000) {
@@ -121,16 +151,28 @@ public:
 
     void Destroy() override {
         GameObject::Destroy();
+        m_timers.Clear();
         while (!game_objects_to_add.empty()) {
             game_objects_to_add.front().first->Destroy();
             game_objects_to_add.pop();
         }
-        for (auto *layer = game_objects; layer != game_objects + RENDERING_LAYERS; layer++) {
-            for (auto game_object : **layer)
+        for (auto &layer : game_objects) {
+            for (auto game_object : layer)
                 if (game_object->onRemoval == DESTROY)
                     game_object->Destroy();
+            layer.Clear();
         }
         m_background.reset();
+        m_backgroundTiles.reset();
+    }
+
+    /**
+     * @return The width of the background image, without zoom
+     */
+    [[nodiscard]] int GetBackgroundWidth() const {
+        if (m_backgroundTiles)
+            return m_backgroundTiles->GetWidth();
+        return m_background ? m_background->getWidth() : 0;
     }
 
     /**
@@ -157,7 +199,7 @@ public:
      * @param layer
      */
     void RemoveImmediately(GameObject *game_object, const int layer) {
-        game_objects[layer]->erase(game_object);
+        game_objects[layer].Erase(game_object);
         if (game_object->onRemoval == DESTROY) {
             game_object->Destroy();
         }
@@ -177,10 +219,26 @@ public:
         return m_camera.y;
     }
 
+    /**
+     * @return The position in the background where the space of the objects starts
+     */
+    [[nodiscard]] const Vector2D &GetOrigin() const {
+        return m_origin;
+    }
+
     Grid *GetGrid() {
         return &m_grid;
     }
 
+    /** Timers of the scene, they fire at the start of its update and are cancelled when it is destroyed */
+    TimerWheel *GetTimers() {
+        return &m_timers;
+    }
+
+    [[nodiscard]] const SceneActivity &GetActivity() const {
+        return m_activity;
+    }
+
     [[nodiscard]] AvancezLib *GetEngine() const {
         return m_engine;
     }
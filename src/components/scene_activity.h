@@ -0,0 +1,109 @@
+#ifndef CONTRA_SCENE_ACTIVITY_H
+#define CONTRA_SCENE_ACTIVITY_H
+
+#include "../kernel/game_object.h"
+#include "../consts.h"
+
+/**
+ * Decides which objects of a scene are updated each frame depending on how far from the camera they are,
+ * so the cost of a frame follows what is on screen rather than everything the level has spawned.
+ *
+ * Only the objects with GameObject::sleepsOffScreen set are affected, by tier:
+ *  - ACTIVE: on screen or within ACTIVITY_FULL_MARGIN of it, updated every frame.
+ *  - NEAR: within ACTIVITY_SLEEP_MARGIN, updated every ACTIVITY_NEAR_PERIOD frames with the time they
+ *    skipped, spread over the frames by object id.
+ *  - ASLEEP: further away, not updated and out of the collision grid (GameObject::OnAsleep). Beyond that
+ *    margin the grid cells and the floor may belong to another part of the level. The time asleep is lost.
+ *
+ * Objects wake up as soon as the camera gets close to them again, or with Wake.
+ *
+ * Only the position of the objects is checked, so objects drawn further than ACTIVITY_FULL_MARGIN from
+ * it (i.e. wide ones anchored at a side) must not opt in: they would be drawn now and then, or not at all,
+ * while still on screen.
+ */
+class SceneActivity {
+public:
+    enum Tier {
+        ACTIVE,
+        NEAR,
+        ASLEEP
+    };
+
+    /** Called once per frame before the objects are updated */
+    void BeginFrame(const Vector2D &camera) {
+        m_camera = camera;
+        m_frame++;
+        m_counts[ACTIVE] = m_counts[NEAR] = m_counts[ASLEEP] = 0;
+    }
+
+    /**
+     * @param dt Time of the frame
+     * @param object_dt Time to update the object with, the one it skipped included
+     * @return Whether the object has to be updated this frame
+     */
+    bool ShouldUpdate(GameObject *game_object, float dt, float &object_dt) {
+        object_dt = dt;
+        if (!game_object->sleepsOffScreen)
+            return true;
+
+        auto &activity = game_object->activity;
+        Tier tier = GetTier(game_object->position);
+        if (activity.awakeTime > 0.f) {
+            activity.awakeTime -= dt;
+            tier = ACTIVE;
+        }
+        m_counts[tier]++;
+        if (tier == ASLEEP) {
+            if (activity.tier != ASLEEP)
+                game_object->OnAsleep();
+            activity.tier = ASLEEP;
+            activity.skippedTime = 0.f;
+            return false;
+        }
+        activity.tier = tier;
+        activity.skippedTime += dt;
+        if (tier == NEAR && (m_frame + game_object->getID()) % ACTIVITY_NEAR_PERIOD != 0)
+            return false;
+        object_dt = activity.skippedTime;
+        activity.skippedTime = 0.f;
+        return true;
+    }
+
+    /**
+     * Keeps the object updated every frame wherever it is, i.e. when something off screen has to react
+     * to an event. It goes back to its tier afterwards.
+     * @param time Seconds to keep it awake
+     */
+    static void Wake(GameObject *game_object, float time = 1.f) {
+        if (game_object->activity.awakeTime < time)
+            game_object->activity.awakeTime = time;
+    }
+
+    [[nodiscard]] Tier GetTier(const Vector2D &position) const {
+        float distance_x = 0.f, distance_y = 0.f;
+        if (position.x < m_camera.x)
+            distance_x = m_camera.x - position.x;
+        else if (position.x > m_camera.x + WINDOW_WIDTH)
+            distance_x = position.x - m_camera.x - WINDOW_WIDTH;
+        if (position.y < m_camera.y)
+            distance_y = m_camera.y - position.y;
+        else if (position.y > m_camera.y + WINDOW_HEIGHT)
+            distance_y = position.y - m_camera.y - WINDOW_HEIGHT;
+        float distance = distance_x > distance_y ? distance_x : distance_y;
+        if (distance <= ACTIVITY_FULL_MARGIN)
+            return ACTIVE;
+        return distance <= ACTIVITY_SLEEP_MARGIN ? NEAR : ASLEEP;
+    }
+
+    // Objects which can sleep found in each tier during the last frame
+    [[nodiscard]] int GetCount(Tier tier) const {
+        return m_counts[tier];
+    }
+
+private:
+    Vector2D m_camera;
+    unsigned int m_frame = 0;
+    int m_counts[3] = {0, 0, 0};
+};
+
+#endif //CONTRA_SCENE_ACTIVITY_H
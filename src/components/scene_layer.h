@@ -0,0 +1,141 @@
+#ifndef CONTRA_SCENE_LAYER_H
+#define CONTRA_SCENE_LAYER_H
+
+#include <vector>
+#include "../kernel/game_object.h"
+
+/**
+ * Game objects of one rendering layer of a scene, stored contiguously and kept in the order they were
+ * added, so they are updated and drawn in spawn order whatever their addresses are.
+ *
+ * Each object remembers its slot, so removing it is O(1): the slot is left empty (skipped when iterating)
+ * and the layer is compacted once per frame, which is safe while the layer is being iterated.
+ */
+class SceneLayer {
+public:
+    class Iterator {
+    public:
+        Iterator(const std::vector<GameObject *> *objects, size_t index) : objects(objects), index(index) {
+            SkipEmpty();
+        }
+
+        GameObject *operator*() const {
+            return (*objects)[index];
+        }
+
+        Iterator &operator++() {
+            index++;
+            SkipEmpty();
+            return *this;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return index < other.index;
+        }
+
+    private:
+        void SkipEmpty() {
+            while (index < objects->size() && (*objects)[index] == nullptr)
+                index++;
+        }
+
+        // By index, objects added while iterating do not invalidate it (they are visited next time)
+        const std::vector<GameObject *> *objects;
+        size_t index;
+    };
+
+    [[nodiscard]] Iterator begin() const {
+        return Iterator(&objects, 0);
+    }
+
+    [[nodiscard]] Iterator end() const {
+        return Iterator(&objects, objects.size());
+    }
+
+    /**
+     * Adds the object after all the others
+     * @return False if the object was already in the layer
+     */
+    bool Insert(GameObject *game_object) {
+        if (Contains(game_object))
+            return false;
+        game_object->layerSlot = int(objects.size());
+        objects.push_back(game_object);
+        count++;
+        return true;
+    }
+
+    /**
+     * Removes the object, leaving its slot empty until the next Compact
+     * @return False if the object was not in the layer
+     */
+    bool Erase(GameObject *game_object) {
+        int slot = game_object->layerSlot;
+        if (!Contains(game_object)) {
+            // The slot belongs to another layer, i.e. the object was moved without being removed first
+            slot = -1;
+            for (size_t i = 0; i < objects.size() && slot < 0; i++)
+                if (objects[i] == game_object)
+                    slot = int(i);
+            if (slot < 0)
+                return false;
+        }
+        objects[slot] = nullptr;
+        game_object->layerSlot = -1;
+        count--;
+        return true;
+    }
+
+    /**
+     * Removes the empty slots and the objects marked to remove, in a single pass keeping the order.
+     * The removed objects are unmarked and handed to on_removed once the layer is consistent again,
+     * so the callback can add or remove other objects.
+     */
+    template<class OnRemoved>
+    void Compact(OnRemoved on_removed) {
+        size_t live = 0;
+        for (auto *game_object : objects) {
+            if (game_object == nullptr)
+                continue;
+            if (game_object->IsMarkedToRemove()) {
+                game_object->layerSlot = -1;
+                removed.push_back(game_object);
+                continue;
+            }
+            game_object->layerSlot = int(live);
+            objects[live++] = game_object;
+        }
+        objects.resize(live); // Keeps the capacity
+        count = live;
+        for (auto *game_object : removed) {
+            game_object->UnmarkToRemove();
+            on_removed(game_object);
+        }
+        removed.clear();
+    }
+
+    [[nodiscard]] bool Contains(const GameObject *game_object) const {
+        int slot = game_object->layerSlot;
+        return slot >= 0 && size_t(slot) < objects.size() && objects[slot] == game_object;
+    }
+
+    // Objects in the layer, without the empty slots
+    [[nodiscard]] size_t Size() const {
+        return count;
+    }
+
+    void Clear() {
+        for (auto *game_object : objects)
+            if (game_object)
+                game_object->layerSlot = -1;
+        objects.clear();
+        count = 0;
+    }
+
+private:
+    std::vector<GameObject *> objects;
+    std::vector<GameObject *> removed; // Reused by Compact
+    size_t count = 0;
+};
+
+#endif //CONTRA_SCENE_LAYER_H
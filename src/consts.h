@@ -11,6 +11,12 @@
 #define SCREEN_PLAYER_LEFT_MARGIN 10
 #define PIXELS_ZOOM 4
 
+// Objects which can sleep off screen are updated every frame within this distance of the screen, every
+// ACTIVITY_NEAR_PERIOD frames up to ACTIVITY_SLEEP_MARGIN and not at all beyond it (see SceneActivity)
+#define ACTIVITY_FULL_MARGIN (32 * PIXELS_ZOOM)
+#define ACTIVITY_SLEEP_MARGIN RENDERING_MARGINS
+#define ACTIVITY_NEAR_PERIOD 4
+
 #define MAX_DEFAULT_BULLETS 4
 #define MAX_FIRE_BULLETS 4
 #define MAX_MACHINE_GUN_BULLETS 6
@@ -18,6 +24,10 @@
 #define MAX_LASER_BULLETS 4
 #define MAX_NPC_BULLETS 40
 
+// Initial sizes of the pools of short lived objects, they grow if needed
+#define MAX_EXPLOSIONS 8
+#define MAX_BRIDGE_EXPLOSIONS 2
+
 #define MAX_BLASTER_CANON_BULLETS 10
 #define MIN_BLAST_X_SPEED 20
 #define MAX_BLAST_X_SPEED 80
@@ -66,4 +76,11 @@
 #define SOUND_EXPLOSION 3
 #define SOUND_PICKUP 4
 
+// Priorities of the sounds when there are no voices left, the higher the more important
+#define SOUND_PRIORITY_HIT 0
+#define SOUND_PRIORITY_WEAPON 1
+#define SOUND_PRIORITY_ENEMY 2
+#define SOUND_PRIORITY_EXPLOSION 3
+#define SOUND_PRIORITY_PLAYER 4
+
 #endif //CONTRA_CONSTS_H
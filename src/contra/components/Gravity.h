@@ -21,6 +21,12 @@ private:
 public:
     void Update(float dt) override;
 
+    void Reset() override {
+        m_velocity = 0;
+        m_onFloor = m_onWater = m_canFall = false;
+        m_lettingFall = false;
+    }
+
     /**
      * Adds vertical velocity, please keep in mind that our coordinate system
      * has inverted y (negative Y is up)
@@ -0,0 +1,130 @@
+#include "floor.h"
+#include <algorithm>
+
+Floor::Floor(const char *path) {
+    SDL_Surface *surface = IMG_Load(path);
+    if (surface == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error loading floor mask %s: %s", path, IMG_GetError());
+        return;
+    }
+    SDL_PixelFormat *fmt = surface->format;
+    if (fmt->BitsPerPixel != 8) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error loading floor mask: not an 8-bit surface.\n");
+        SDL_FreeSurface(surface);
+        return;
+    }
+    m_floorWidth = surface->w;
+    m_floorHeight = surface->h;
+
+    // Lets loop over the surface pixels, black is air, white is sea, gray is whater.
+    // Each chunk is unpacked only to be packed, so the whole mask is never held unpacked.
+    Pixels column_pixels(new FloorPixel[size_t(CHUNK_WIDTH) * m_floorHeight]);
+    SDL_LockSurface(surface);
+    for (int x0 = 0; x0 < m_floorWidth; x0 += CHUNK_WIDTH) {
+        Chunk chunk;
+        chunk.width = std::min(CHUNK_WIDTH, m_floorWidth - x0);
+        for (int y = 0; y < m_floorHeight; y++) {
+            // Rows are pitch bytes apart, which can be more than the width
+            auto *row = (Uint8 *) surface->pixels + y * surface->pitch + x0;
+            for (int x = 0; x < chunk.width; x++) {
+                auto color = &fmt->palette->colors[row[x]];
+                FloorPixel value;
+                if (color->r < 100) {
+                    value = AIR;
+                } else if (color->r < 150) {
+                    value = WATER;
+                } else if (color->r < 200) {
+                    value = FLOOR_NO_FALL;
+                } else {
+                    value = FLOOR;
+                }
+                column_pixels[x * m_floorHeight + y] = value;
+            }
+        }
+        chunk.packed = Pack(column_pixels.get(), chunk.width, m_floorHeight);
+        m_chunks.push_back(std::move(chunk));
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+}
+
+void Floor::Stream(int x_min, int x_max) {
+    if (m_chunks.empty())
+        return;
+    int first = std::max(x_min / CHUNK_WIDTH, 0);
+    int last = std::min(x_max / CHUNK_WIDTH, int(m_chunks.size()) - 1);
+    for (int i = 0, count = int(m_chunks.size()); i < count; i++) {
+        Chunk &chunk = m_chunks[i];
+        if (i >= first && i <= last) {
+            if (!chunk.pixels && !chunk.loading.valid()) {
+                chunk.loading = std::async(std::launch::async, &Floor::Unpack, chunk.packed, chunk.width,
+                                           m_floorHeight);
+            } else if (chunk.loading.valid()
+                       && chunk.loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                chunk.pixels = chunk.loading.get();
+            }
+        } else {
+            // Left behind, it is still packed
+            if (chunk.loading.valid()
+                && chunk.loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                chunk.loading.get();
+            if (!chunk.loading.valid())
+                chunk.pixels.reset();
+        }
+    }
+}
+
+void Floor::SetAir(int x0, int y0, int width, int height) {
+    int x_end = std::min(x0 + width, m_floorWidth), y_end = std::min(y0 + height, m_floorHeight);
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    for (int x = x0; x < x_end;) {
+        int index = x / CHUNK_WIDTH;
+        ChunkPixels(index);
+        Chunk &chunk = m_chunks[index];
+        int chunk_end = std::min(index * CHUNK_WIDTH + chunk.width, x_end);
+        for (; x < chunk_end; x++) {
+            for (int y = y0; y < y_end; y++) {
+                chunk.pixels[(x % CHUNK_WIDTH) * m_floorHeight + y] = AIR;
+            }
+        }
+        // Packed again so the change survives the chunk being dropped
+        chunk.packed = Pack(chunk.pixels.get(), chunk.width, m_floorHeight);
+    }
+}
+
+const Floor::FloorPixel *Floor::ChunkPixels(int index) {
+    Chunk &chunk = m_chunks[index];
+    if (!chunk.pixels) {
+        if (chunk.loading.valid())
+            chunk.pixels = chunk.loading.get(); // Not far from done, it was requested ahead of the camera
+        else
+            chunk.pixels = Unpack(chunk.packed, chunk.width, m_floorHeight);
+    }
+    return chunk.pixels.get();
+}
+
+std::shared_ptr<const Floor::PackedPixels> Floor::Pack(const FloorPixel *pixels, int width, int height) {
+    auto packed = std::make_shared<PackedPixels>();
+    const FloorPixel *end = pixels + size_t(width) * height;
+    while (pixels < end) {
+        Uint8 length = 1;
+        while (pixels + length < end && length < 255 && pixels[length] == pixels[0])
+            length++;
+        packed->push_back(length);
+        packed->push_back(pixels[0]);
+        pixels += length;
+    }
+    packed->shrink_to_fit();
+    return packed;
+}
+
+Floor::Pixels Floor::Unpack(std::shared_ptr<const PackedPixels> packed, int width, int height) {
+    Pixels pixels(new FloorPixel[size_t(width) * height]);
+    FloorPixel *out = pixels.get();
+    for (size_t i = 0; i + 1 < packed->size(); i += 2) {
+        std::fill(out, out + (*packed)[i], FloorPixel((*packed)[i + 1]));
+        out += (*packed)[i];
+    }
+    return pixels;
+}
@@ -6,66 +6,34 @@
 #define CONTRA_FLOOR_H
 
 #include <SDL_image.h>
+#include <future>
 #include <memory>
+#include <vector>
 
+/**
+ * Floor mask of a level, split in chunks of CHUNK_WIDTH columns so its memory does not grow with the
+ * length of the level. All the chunks are kept run-length packed, which is tiny for a mask, and only
+ * the chunks around the camera are unpacked. Stream unpacks the chunks ahead of the camera on a worker
+ * thread and drops the ones left behind, a query on a chunk which is not ready unpacks it on the spot,
+ * so the queries work the same across the chunk boundaries and anywhere in the level.
+ */
 class Floor {
-private:
-    enum FloorPixel {
-        AIR,
-        FLOOR,
-        FLOOR_NO_FALL,
-        WATER
-    };
-    std::unique_ptr<FloorPixel> m_map;
-    int m_floorWidth, m_floorHeight;
 public:
-    SDL_Surface *surface;
-
-    Floor(const char *path) {
-        surface = IMG_Load(path);
-        SDL_PixelFormat *fmt = surface->format;
-
-        m_floorWidth = surface->w;
-        m_floorHeight = surface->h;
-        int map_size = m_floorHeight * m_floorWidth;
-        m_map.reset(new FloorPixel[map_size]);
-
-        if (fmt->BitsPerPixel != 8) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Error loading floor mask: not an 8-bit surface.\n");
-            return;
-        }
-
-        // Lets loop over the surface pixels, black is air, white is sea, gray is whater
-        SDL_LockSurface(surface);
-        auto *pixel = (Uint8 *) surface->pixels;
-        auto *map = m_map.get();
-        int x = 0;
-        for (auto *mappedPixel = m_map.get(); mappedPixel < map + map_size; mappedPixel++, pixel++, x++) {
-            // We need to pay attention to this, it seems that SDL saves an extra pixel per line for some reason(?)
-            if (x == m_floorWidth) {
-                x = -1;
-                mappedPixel--;
-                continue;
-            }
-            auto color = &fmt->palette->colors[*pixel];
-            if (color->r < 100) {
-                *mappedPixel = AIR;
-            } else if (color->r < 150) {
-                *mappedPixel = WATER;
-            } else if (color->r < 200) {
-                *mappedPixel = FLOOR_NO_FALL;
-            } else {
-                *mappedPixel = FLOOR;
-            }
-        }
-        SDL_UnlockSurface(surface);
-        SDL_FreeSurface(surface);
-    }
+    // Level pixels per chunk, one screen
+    static constexpr int CHUNK_WIDTH = 256;
+
+    explicit Floor(const char *path);
 
     int getWidth() { return m_floorWidth; }
 
     int getHeight() { return m_floorHeight; }
 
+    /**
+     * Keeps unpacked the chunks between the given columns, loading the missing ones in the background,
+     * and frees the others. Should be called once per frame with the columns around the camera.
+     */
+    void Stream(int x_min, int x_max);
+
     bool IsFloor(int x, int y) {
         auto value = GetFloorPixel(x, y);
         return value == FLOOR || value == FLOOR_NO_FALL;
@@ -84,18 +52,43 @@ public:
         return value == FLOOR || value == WATER || value == FLOOR_NO_FALL;
     }
 
-    void SetAir(int x0, int y0, int width, int height) {
-        for (int y = y0; y < y0 + height; y++) {
-            for (int x = x0; x < x0 + width; x++) {
-                m_map.get()[y * m_floorWidth + x] = AIR;
-            }
-        }
-    }
+    void SetAir(int x0, int y0, int width, int height);
+
 private:
+    enum FloorPixel : Uint8 {
+        AIR,
+        FLOOR,
+        FLOOR_NO_FALL,
+        WATER
+    };
+
+    typedef std::vector<Uint8> PackedPixels; // Pairs of run length and FloorPixel, column by column
+    typedef std::unique_ptr<FloorPixel[]> Pixels;
+
+    struct Chunk {
+        int width;
+        // Shared with the loads in progress, replaced (never modified) when the floor changes
+        std::shared_ptr<const PackedPixels> packed;
+        Pixels pixels; // Column by column, nullptr if not unpacked
+        std::future<Pixels> loading;
+    };
+
+    std::vector<Chunk> m_chunks;
+    int m_floorWidth = 0, m_floorHeight = 0;
+
+    static std::shared_ptr<const PackedPixels> Pack(const FloorPixel *pixels, int width, int height);
+
+    static Pixels Unpack(std::shared_ptr<const PackedPixels> packed, int width, int height);
+
+    // The pixels of the chunk, unpacking it now if it is not ready
+    const FloorPixel *ChunkPixels(int chunk);
+
     FloorPixel GetFloorPixel(int x, int y) {
+        if (m_chunks.empty())
+            return AIR;
         x = std::max(std::min(x, m_floorWidth - 1), 0);
         y = std::max(std::min(y, m_floorHeight - 1), 0);
-        return m_map.get()[y * m_floorWidth + x];
+        return ChunkPixels(x / CHUNK_WIDTH)[(x % CHUNK_WIDTH) * m_floorHeight + y];
     }
 };
 
@@ -13,28 +13,28 @@ void PlayerControl::Init() {
     m_animator = go->GetComponent<AnimationRenderer *>();
     m_collider = go->GetComponent<BoxCollider *>();
     m_gravity = go->GetComponent<Gravity *>();
-    m_idleAnim = m_animator->FindAnimation("Idle");
-    m_jumpAnim = m_animator->FindAnimation("Jump");
-    m_runAnim = m_animator->FindAnimation("Run");
-    m_upAnim = m_animator->FindAnimation("Up");
-    m_fallAnim = m_animator->FindAnimation("Fall");
-    m_crawlAnim = m_animator->FindAnimation("Crawl");
-    m_dieAnim = m_animator->FindAnimation("Die");
-    m_runUpAnim = m_animator->FindAnimation("RunUp");
-    m_runDownAnim = m_animator->FindAnimation("RunDown");
-    m_runShootAnim = m_animator->FindAnimation("RunShoot");
-    m_splashAnim = m_animator->FindAnimation("Splash");
-    m_swimAnim = m_animator->FindAnimation("Swim");
-    m_diveAnim = m_animator->FindAnimation("Dive");
-    m_swimShootAnim = m_animator->FindAnimation("SwimShoot");
-    m_swimShootDiagonalAnim = m_animator->FindAnimation("SwimShootDiagonal");
-    m_swimShootUpAnim = m_animator->FindAnimation("SwimShootUp");
-    m_persIdleAnim = m_animator->FindAnimation("PerspectiveIdle");
-    m_persCrawlAnim = m_animator->FindAnimation("PerspectiveCrawl");
-    m_persRunAnim = m_animator->FindAnimation("PerspectiveRun");
-    m_persFryingAnim = m_animator->FindAnimation("PerspectiveFrying");
-    m_persDyingAnim = m_animator->FindAnimation("PerspectiveDie");
-    m_persForward = m_animator->FindAnimation("PerspectiveForward");
+    m_idleAnim = m_animator->FindAnimation(AnimationId("Idle"));
+    m_jumpAnim = m_animator->FindAnimation(AnimationId("Jump"));
+    m_runAnim = m_animator->FindAnimation(AnimationId("Run"));
+    m_upAnim = m_animator->FindAnimation(AnimationId("Up"));
+    m_fallAnim = m_animator->FindAnimation(AnimationId("Fall"));
+    m_crawlAnim = m_animator->FindAnimation(AnimationId("Crawl"));
+    m_dieAnim = m_animator->FindAnimation(AnimationId("Die"));
+    m_runUpAnim = m_animator->FindAnimation(AnimationId("RunUp"));
+    m_runDownAnim = m_animator->FindAnimation(AnimationId("RunDown"));
+    m_runShootAnim = m_animator->FindAnimation(AnimationId("RunShoot"));
+    m_splashAnim = m_animator->FindAnimation(AnimationId("Splash"));
+    m_swimAnim = m_animator->FindAnimation(AnimationId("Swim"));
+    m_diveAnim = m_animator->FindAnimation(AnimationId("Dive"));
+    m_swimShootAnim = m_animator->FindAnimation(AnimationId("SwimShoot"));
+    m_swimShootDiagonalAnim = m_animator->FindAnimation(AnimationId("SwimShootDiagonal"));
+    m_swimShootUpAnim = m_animator->FindAnimation(AnimationId("SwimShootUp"));
+    m_persIdleAnim = m_animator->FindAnimation(AnimationId("PerspectiveIdle"));
+    m_persCrawlAnim = m_animator->FindAnimation(AnimationId("PerspectiveCrawl"));
+    m_persRunAnim = m_animator->FindAnimation(AnimationId("PerspectiveRun"));
+    m_persFryingAnim = m_animator->FindAnimation(AnimationId("PerspectiveFrying"));
+    m_persDyingAnim = m_animator->FindAnimation(AnimationId("PerspectiveDie"));
+    m_persForward = m_animator->FindAnimation(AnimationId("PerspectiveForward"));
     m_animator->PlayAnimation(m_jumpAnim); // Start jumping
     m_previousKeyStatus = {false, false, false, false, false, false, false,
                            false};
@@ -45,7 +45,11 @@ void PlayerControl::Init() {
 
 void PlayerControl::Kill() {
     m_isDeath = true;
-    m_waitDead = 2.f;
+    auto *timers = level->GetTimers();
+    timers->Cancel(m_respawnTimer);
+    m_respawnTimer = timers->Schedule(2.f, [this]() {
+        OnDeathWaited();
+    });
     go->Send(m_index == 0 ? LIFE_LOST_1 : LIFE_LOST_2);
     m_animator->PlayAnimation(PickDieAnimation());
     level->GetSound(SOUND_PLAYER_DEATH)->Play(1);
@@ -63,11 +67,35 @@ void PlayerControl::Respawn() {
     m_currentWeapon.reset(new DefaultWeapon(level, m_index));
     m_facingRight = true;
     m_hasInertia = false;
-    m_invincibleTime = 2.f;
+    StartInvincibility(2.f);
     m_isDeath = false;
     OnSpawn();
 }
 
+void PlayerControl::OnDeathWaited() {
+    if (m_remainingLives > -1) {
+        m_remainingLives--;
+        if (m_remainingLives >= 0) {
+            Respawn();
+        }
+    }
+}
+
+void PlayerControl::StartInvincibility(float time) {
+    auto *timers = level->GetTimers();
+    timers->Cancel(m_invincibleTimer);
+    m_invincibleTimer = timers->Schedule(time, [this]() {
+        m_animator->enabled = true; // Stops twinkling
+    });
+}
+
+void PlayerControl::Destroy() {
+    auto *timers = level->GetTimers();
+    timers->Cancel(m_respawnTimer);
+    timers->Cancel(m_invincibleTimer);
+    LevelComponent::Destroy();
+}
+
 void PlayerControl::OnCollision(const CollideComponent &collider) {
     if (m_isDeath) return;
 
@@ -90,6 +118,8 @@ void PlayerControl::OnCollision(const CollideComponent &collider) {
     auto *pickup = collider.GetGameObject()->GetComponent<PickUpBehaviour *>();
     if (pickup) {
         PickUp(pickup->GetType());
+        // Disabled so a pickup from a pool can be reused
+        pickup->GetGameObject()->Disable();
         // Safe to erase as it is not the current layer (current layer is player layer)
         level->RemoveImmediately(pickup->GetGameObject(), RENDERING_LAYER_ENEMIES);
     }
@@ -193,35 +223,24 @@ void PlayerControl::Update(float dt) {
     if (keyStatus.debug && !m_previousKeyStatus.debug) {
         m_godMode = !m_godMode;
         SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "God mode: %s", m_godMode ? "ON" : "OFF");
-        if (!m_godMode) m_invincibleTime = dt;
+        if (!m_godMode && level->GetTimers()->Cancel(m_invincibleTimer)) m_animator->enabled = true;
     }
 
-    if (m_godMode && m_invincibleTime < 1.0f) {
-        m_invincibleTime = 100.f;
+    auto *timers = level->GetTimers();
+    if (m_godMode && timers->GetRemaining(m_invincibleTimer) < 1.0f) {
+        StartInvincibility(100.f);
     }
 
-    if (m_invincibleTime > 0) {
-        bool display = (int) round(m_invincibleTime * 10) % 2 == 0;
-        m_invincibleTime -= dt;
-        if (m_invincibleTime <= 0) display = true;
-        m_animator->enabled = display; // It appears and twinkles when invincible
+    if (timers->IsPending(m_invincibleTimer)) {
+        // It appears and twinkles when invincible
+        m_animator->enabled = (int) round(timers->GetRemaining(m_invincibleTimer) * 10) % 2 == 0;
     }
 
-    // If it is death, wait for death animation to end and then decide
+    // If it is death, wait for death animation to end, the respawn timer decides then
     if (m_isDeath) {
-        if (m_waitDead <= 0) {
-            if (m_remainingLives > -1) {
-                m_remainingLives--;
-                if (m_remainingLives >= 0) {
-                    Respawn();
-                }
-            }
-        } else {
-            m_waitDead -= dt;
-            if (m_animator->IsPlaying(m_dieAnim)) {
-                go->position =
-                        go->position + Vector2D(PLAYER_SPEED * PIXELS_ZOOM * dt * (m_facingRight ? -1.f : 1.f), 0);
-            }
+        if (timers->IsPending(m_respawnTimer) && m_animator->IsPlaying(m_dieAnim)) {
+            go->position =
+                    go->position + Vector2D(PLAYER_SPEED * PIXELS_ZOOM * dt * (m_facingRight ? -1.f : 1.f), 0);
         }
         return;
     }
@@ -293,7 +312,7 @@ void PlayerControl::Update(float dt) {
 }
 
 bool PlayerControl::CanBeHit() {
-    return !m_isDeath && m_invincibleTime <= 0 && !m_diving;
+    return !m_isDeath && !level->GetTimers()->IsPending(m_invincibleTimer) && !m_diving;
 }
 
 void PlayerControlScrolling::AnimationUpdate(bool shooting, const AvancezLib::KeyStatus &keyStatus, Box **box,
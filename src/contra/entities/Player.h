@@ -36,6 +36,8 @@ public:
 
     void Respawn();
 
+    void Destroy() override;
+
     void OnCollision(const CollideComponent &collider) override;
 
     [[nodiscard]] short getRemainingLives() const { return m_remainingLives; }
@@ -58,7 +60,7 @@ protected:
     bool m_hasInertia;
     bool m_godMode;
     short m_index;
-    float m_waitDead, m_invincibleTime;
+    TimerHandle m_respawnTimer, m_invincibleTimer;
     bool m_isDeath;
     bool m_facingRight;
     bool m_wasInWater;
@@ -102,6 +104,13 @@ protected:
     virtual AvancezLib::KeyStatus GetKeyStatusWhenComplete() = 0;
 
     [[nodiscard]] virtual int PickDieAnimation() const { return m_dieAnim; }
+
+private:
+    // Called once the death has been shown, it respawns if there are lives left
+    void OnDeathWaited();
+
+    // Can not be hit for the time given, twinkling meanwhile
+    void StartInvincibility(float time);
 };
 
 class PlayerControlScrolling : public PlayerControl {
@@ -40,8 +40,8 @@ public:
         m_maxY = y_max;
         if (!m_renderer) {
             m_renderer = go->GetComponent<AnimationRenderer *>();
-            m_animBullet = m_renderer->FindAnimation("Bullet");
-            m_animKill = m_renderer->FindAnimation("Kill");
+            m_animBullet = m_renderer->FindAnimation(AnimationId("Bullet"));
+            m_animKill = m_renderer->FindAnimation(AnimationId("Kill"));
         }
         if (!m_collider) m_collider = go->GetComponent<CollideComponent *>();
         m_renderer->PlayAnimation(m_animBullet);
@@ -6,8 +6,8 @@
 #include "../../components/collision/BoxCollider.h"
 #include "bullets.h"
 
-void CanonBehaviour::OnCollision(const CollideComponent &collider) {
-    if (m_life > 0 && m_state == SHOWN) {
+bool CanonBehaviour::AcceptCollision(const CollideComponent &collider) {
+    if (m_life > 0 && m_shown) {
         auto *bullet = collider.GetGameObject()->GetComponent<BulletBehaviour *>();
         if (bullet && !bullet->IsKilled()) {
             m_life -= bullet->GetDamage();
@@ -19,8 +19,10 @@ void CanonBehaviour::OnCollision(const CollideComponent &collider) {
             } else {
                 level->GetSound(SOUND_ENEMY_HIT)->Play(1);
             }
+            return true;
         }
     }
+    return false;
 }
 
 void CanonBehaviour::Fire() {
@@ -35,57 +37,53 @@ void CanonBehaviour::Fire() {
     }
 }
 
-void CanonBehaviour::Update(float dt) {
-    if (m_life == 0) {
-        if (!m_animator->IsCurrent(animDie)) {
-            m_animator->PlayAnimation(animDie);
-        } else if (!m_animator->IsPlaying()) {
-            go->MarkToRemove();
+void CanonBehaviour::Run(float dt) {
+    TASK_BEGIN();
+    while (true) {
+        Hide();
+        TASK_WAIT_UNTIL(IsPlayerApproaching());
+        Show();
+        TASK_WAIT_UNTIL(!m_animator->IsPlaying() && GetClosestPlayer());
+        m_dir = std::max(std::min(DirToInt(GetPlayerDir(GetClosestPlayer())), m_maxDir), m_minDir);
+        m_animator->PlayAnimation(animDirsFirst + m_dir - m_minDir);
+        m_currentDirTime = 0;
+
+        m_shown = true;
+        while (m_life > 0 && !IsPlayerGone()) {
+            AimAndShoot(dt);
+            TASK_YIELD();
         }
-        return;
-    }
-    auto *closestPlayer = GetClosestPlayer();
-    if (!closestPlayer) return;
-    Vector2D player_dir = GetPlayerDir(closestPlayer);
-    switch (m_state) {
-        case HIDDEN:
-            UpdateHidden(closestPlayer, player_dir, dt);
-            break;
-        case SHOWING:
-            UpdateShowing(closestPlayer, player_dir, dt);
-            break;
-        case SHOWN:
-            UpdateShown(closestPlayer, player_dir, dt);
-            break;
-        case HIDING:
-            UpdateHiding(closestPlayer, player_dir, dt);
+        m_shown = false;
+        if (m_life <= 0)
             break;
+        m_animator->PlayAnimation(animShowing, false);
+        TASK_WAIT_ANIMATION(m_animator);
     }
+
+    m_animator->PlayAnimation(animDie);
+    TASK_WAIT_ANIMATION(m_animator);
+    go->MarkToRemove();
+    TASK_END();
 }
 
-void CanonBehaviour::UpdateHidden(const PlayerControl *playerControl, const Vector2D &player_dir, float dt) {
-    m_animator->PlayAnimation(animHidden);
-    if (player_dir.x > -WINDOW_WIDTH / 2 + 16 * PIXELS_ZOOM && player_dir.x < 0) {
-        m_animator->PlayAnimation(animShowing);
-        m_state = SHOWING;
-    }
+bool CanonBehaviour::IsPlayerApproaching() {
+    PlayerControl *player_control;
+    Vector2D player_dir;
+    return FindPlayer(player_control, player_dir)
+           && player_dir.x > -WINDOW_WIDTH / 2 + 16 * PIXELS_ZOOM && player_dir.x < 0;
 }
 
-void CanonBehaviour::UpdateShowing(const PlayerControl *playerControl, const Vector2D &player_dir, float dt) {
-    if (!m_animator->IsPlaying()) {
-        m_dir = std::max(std::min(DirToInt(player_dir), m_maxDir), m_minDir);
-        m_animator->PlayAnimation(animDirsFirst + m_dir - m_minDir);
-        m_state = SHOWN;
-        m_currentDirTime = 0;
-    }
+bool CanonBehaviour::IsPlayerGone() {
+    PlayerControl *player_control;
+    Vector2D player_dir;
+    return FindPlayer(player_control, player_dir) && player_dir.x > WINDOW_WIDTH / 2 - 25 * PIXELS_ZOOM;
 }
 
-void CanonBehaviour::UpdateShown(const PlayerControl *playerControl, const Vector2D &player_dir, float dt) {
-    if (player_dir.x > WINDOW_WIDTH / 2 - 25 * PIXELS_ZOOM) {
-        m_animator->PlayAnimation(animShowing, false);
-        m_state = HIDING;
+void CanonBehaviour::AimAndShoot(float dt) {
+    PlayerControl *player_control;
+    Vector2D player_dir;
+    if (!FindPlayer(player_control, player_dir))
         return;
-    }
 
     m_currentDirTime += dt;
     int target_dir = DirToInt(player_dir);
@@ -114,7 +112,7 @@ void CanonBehaviour::UpdateShown(const PlayerControl *playerControl, const Vecto
     if (m_fireRemainingCooldown > 0) {
         m_fireRemainingCooldown -= dt;
     } else if ((m_shotBulletsInBurst < m_burstLength || m_burstRemainingCooldown <= 0)
-               && m_dir == target_dir && playerControl->IsAlive() && !is_default) {
+               && m_dir == target_dir && player_control->IsAlive() && !is_default) {
         if (m_burstRemainingCooldown <= 0) {
             m_shotBulletsInBurst = 0; // New burst
             m_burstRemainingCooldown = m_burstCooldown;
@@ -125,13 +123,9 @@ void CanonBehaviour::UpdateShown(const PlayerControl *playerControl, const Vecto
     }
 }
 
-void CanonBehaviour::UpdateHiding(const PlayerControl *playerControl, const Vector2D &player_dir, float dt) {
-    if (!m_animator->IsPlaying()) m_state = HIDDEN;
-}
-
 void CanonBehaviour::Create(Level *level, GameObject *go, int min_dir, int max_dir, int default_dir,
                             float rotation_interval, int burst_length, float burst_cooldown, float shoot_cooldown) {
-    LevelComponent::Create(level, go);
+    LevelTask::Create(level, go);
     m_rotationInterval = rotation_interval;
     m_minDir = min_dir;
     m_maxDir = max_dir;
@@ -141,15 +135,6 @@ void CanonBehaviour::Create(Level *level, GameObject *go, int min_dir, int max_d
     m_burstLength = burst_length;
 }
 
-void GulcanBehaviour::UpdateHidden(const PlayerControl *playerControl, const Vector2D &player_dir, float dt) {
-    m_animator->enabled = false;
-    if (player_dir.x > -WINDOW_WIDTH / 2 + 16 * PIXELS_ZOOM && player_dir.x < 0) {
-        m_animator->enabled = true;
-        m_animator->PlayAnimation(animShowing);
-        m_state = SHOWING;
-    }
-}
-
 void RotatingCanon::Create(Level *level, const Vector2D &pos, int burst_length) {
     GameObject::Create();
     position = pos;
@@ -6,7 +6,7 @@
 #define CONTRA_CANONS_H
 
 #include <memory>
-#include "../level/level_component.h"
+#include "../level/level_task.h"
 #include "Player.h"
 
 class RotatingCanon : public GameObject {
@@ -19,15 +19,9 @@ public:
     void Create(Level* level, const Vector2D &pos);
 };
 
-class CanonBehaviour : public LevelComponent, public CollideComponentListener {
+class CanonBehaviour : public LevelTask {
 protected:
-    enum CanonState {
-        HIDDEN,
-        SHOWING,
-        SHOWN,
-        HIDING
-    };
-    CanonState m_state;
+    bool m_shown; // Can be hit
     unsigned short m_scoreGiven = 100;
     int m_dir, m_minDir, m_maxDir, m_defaultDir;
     float m_currentDirTime, m_fireRemainingCooldown, m_burstRemainingCooldown;
@@ -65,31 +59,59 @@ protected:
     }
 
     void Fire();
+
+    // Direction to the closest player, false if there is none
+    bool FindPlayer(PlayerControl *&player_control, Vector2D &player_dir) {
+        player_control = GetClosestPlayer();
+        if (!player_control)
+            return false;
+        player_dir = GetPlayerDir(player_control);
+        return true;
+    }
+
+    // Whether the closest player is close enough on the left to open
+    bool IsPlayerApproaching();
+
+    // Whether the closest player has gone far enough to the right to close
+    bool IsPlayerGone();
+
+    // Turns towards the closest player and shoots at it when aiming at it
+    void AimAndShoot(float dt);
+
+    void Run(float dt) override;
+
+    bool AcceptCollision(const CollideComponent &collider) override;
+
+    // How it looks while closed
+    virtual void Hide() {
+        m_animator->PlayAnimation(animHidden);
+    }
+
+    virtual void Show() {
+        m_animator->PlayAnimation(animShowing);
+    }
 public:
     void Create(Level* level, GameObject *go, int min_dir, int max_dir, int m_defaultDir, float rotation_interval,
                 int burst_length, float burst_cooldown, float shoot_cooldown);
     void Init() override {
-        Component::Init();
+        LevelTask::Init();
         m_animator = go->GetComponent<AnimationRenderer *>();
-        animHidden = m_animator->FindAnimation("Closed");
-        animShowing = m_animator->FindAnimation("Opening");
-        animDirsFirst = m_animator->FindAnimation("Dir0");
-        animDie = m_animator->FindAnimation("Dying");
+        animHidden = m_animator->FindAnimation(AnimationId("Closed"));
+        animShowing = m_animator->FindAnimation(AnimationId("Opening"));
+        animDirsFirst = m_animator->FindAnimation(AnimationId("Dir0"));
+        animDie = m_animator->FindAnimation(AnimationId("Dying"));
         m_life = 8;
         m_fireRemainingCooldown = 0;
         m_burstRemainingCooldown = m_burstCooldown;
         m_shotBulletsInBurst = 0;
-        m_state = HIDDEN;
+        m_shown = false;
+    }
+    void SetBurstLength(int burst_length) {
+        m_burstLength = burst_length;
     }
-    void Update(float dt) final;
-    virtual void UpdateHidden(const PlayerControl* playerControl, const Vector2D& player_dir, float dt);
     virtual PlayerControl* GetClosestPlayer() {
         return level->GetClosestPlayerControl(go->position);
     }
-    void UpdateShowing(const PlayerControl* playerControl, const Vector2D& player_dir, float dt);
-    void UpdateShown(const PlayerControl* playerControl, const Vector2D& player_dir, float dt);
-    void UpdateHiding(const PlayerControl* playerControl, const Vector2D& player_dir, float dt);
-    void OnCollision(const CollideComponent &collider) override;
 };
 
 class GulcanBehaviour: public CanonBehaviour {
@@ -102,7 +124,16 @@ public:
         return level->GetClosestPlayerControl(go->position, true);
     }
 
-    void UpdateHidden(const PlayerControl* playerControl, const Vector2D &player_dir, float dt) override;
+protected:
+    // Not drawn at all while closed
+    void Hide() override {
+        m_animator->enabled = false;
+    }
+
+    void Show() override {
+        m_animator->enabled = true;
+        CanonBehaviour::Show();
+    }
 };
 
 #endif //CONTRA_CANONS_H
@@ -78,10 +78,8 @@ public:
     void OnKill() {
         go->Send(SCORE1_1000);
 
-        auto *explosion = new Explosion();
-        explosion->Create(level, go->position + Vector2D(3, 3) * PIXELS_ZOOM);
-        explosion->Init();
-        level->AddGameObject(explosion, RENDERING_LAYER_BULLETS);
+        level->AddGameObject(level->SpawnExplosion(go->position + Vector2D(3, 3) * PIXELS_ZOOM),
+                             RENDERING_LAYER_BULLETS);
         go->Disable();
     }
 
@@ -171,24 +169,8 @@ public:
     }
 
     void CreateExplosion(const Vector2D &pos) {
-        auto *explosion = new GameObject();
-        explosion->Create();
-        auto *renderer = new AnimationRenderer();
-        renderer->Create(level, explosion, level->GetSpritesheet(SPRITESHEET_ENEMIES));
-        renderer->AddAnimation({
-                92, 611, 0.15, 3,
-                30, 30, 15, 15,
-                "Explosion", AnimationRenderer::BOUNCE_AND_STOP});
-        renderer->Play();
-        auto *self_destroy = new DestroyOnAnimationStop();
-        self_destroy->Create(level, explosion);
-        explosion->AddComponent(renderer);
-        explosion->AddComponent(self_destroy);
-        explosion->position = pos;
-
-        explosion->Init();
-        level->GetSound(SOUND_EXPLOSION)->Play(1);
-        level->AddGameObject(explosion, RENDERING_LAYER_BULLETS);
+        // The explosion plays its own sound
+        level->AddGameObject(level->SpawnExplosion(pos), RENDERING_LAYER_BULLETS);
     }
 };
 
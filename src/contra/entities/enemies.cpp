@@ -54,17 +54,7 @@ void Ledder::Create(Level *level, float time_hidden, float time_shown, float coo
             time_hidden, time_shown, cooldown_time, show_standing, burst_length, burst_cooldown, horizontally_precise);
 
     auto *collider = new BoxCollider();
-    if (show_standing) {
-        collider->Create(level, this,
-                -6 * PIXELS_ZOOM, -27 * PIXELS_ZOOM,
-                12 * PIXELS_ZOOM, 28 * PIXELS_ZOOM,
-                -1, NPCS_COLLISION_LAYER);
-    } else {
-        collider->Create(level, this,
-                -6 * PIXELS_ZOOM, -10 * PIXELS_ZOOM,
-                10 * PIXELS_ZOOM, 15 * PIXELS_ZOOM,
-                -1, NPCS_COLLISION_LAYER);
-    }
+    collider->Create(level, this, LedderBox(show_standing), -1, NPCS_COLLISION_LAYER);
     collider->SetListener(behaviour);
 
     AddComponent(behaviour);
@@ -72,67 +62,84 @@ void Ledder::Create(Level *level, float time_hidden, float time_shown, float coo
     AddComponent(renderer);
 }
 
-void LedderBehaviour::Update(float dt) {
-    m_currentStateTime += dt;
-    switch (m_state) {
-        case SHOWN:
-            // If m_timeHidden is 0 or less, we do not transition back
-            if (m_currentStateTime > m_timeShown && m_timeHidden > 0) {
-                m_animator->PlayAnimation(m_animShow, false);
-                ChangeToState(HIDING);
-            } else {
-                if (level->GetCameraX() + WINDOW_WIDTH < go->position.x) break; // Wait to be in camera
-                if (m_burstCoolDown > 0) m_burstCoolDown -= dt;
-                if (m_coolDown > 0) m_coolDown -= dt;
-                if (m_coolDown <= 0 && (m_firedInBurst < m_burstLength || m_burstCoolDown <= 0)) {
-                    auto* closestPlayer = level->GetClosestPlayer(go->position);
-                    if (!closestPlayer) break;
-                    if (m_showStanding or (go->position.y < closestPlayer->position.y
-                                           && go->position.y > closestPlayer->position.y - 33 * PIXELS_ZOOM)) {
-                        if (m_burstCoolDown <= 0) {
-                            m_burstCoolDown = m_burstCoolDownTime;
-                            m_firedInBurst = 0; // New burst
-                        }
-                        Fire();
-                        m_coolDown = m_coolDownTime;
-                        m_firedInBurst++;
-                    }
-                }
-            }
-            break;
-        case HIDDEN:
-            if (m_currentStateTime > m_timeHidden) {
-                m_animator->PlayAnimation(m_animShow, true);
-                ChangeToState(SHOWING);
-            }
-            break;
-        case HIDING:
-        case SHOWING:
-            if (!m_animator->IsPlaying())
-                ChangeToState(m_state == HIDING ? HIDDEN : SHOWN);
-            break;
-        case GOING_TO_DIE:
-            if (!m_animator->IsPlaying()) {
-                m_animator->PlayAnimation(m_animDying);
-                level->GetSound(SOUND_ENEMY_DEATH)->Play(1);
-                ChangeToState(DYING);
-            } else {
-                go->position = go->position + Vector2D(m_animator->mirrorHorizontal ? -0.5f : 0.5f, -1);
-            }
+void Ledder::Configure(float time_hidden, float time_shown, float cooldown_time, bool show_standing,
+                       int burst_length, float burst_cooldown, bool horizontally_precise) {
+    GetComponent<LedderBehaviour *>()->SetParameters(
+            time_hidden, time_shown, cooldown_time, show_standing, burst_length, burst_cooldown, horizontally_precise);
+    GetComponent<BoxCollider *>()->ChangeBox(LedderBox(show_standing));
+}
+
+Box Ledder::LedderBox(bool show_standing) {
+    if (show_standing)
+        return Box{-6, -27, 6, 1} * PIXELS_ZOOM;
+    return Box{-6, -10, 4, 5} * PIXELS_ZOOM;
+}
+
+void LedderBehaviour::Run(float dt) {
+    TASK_BEGIN();
+    while (!m_hit) {
+        // If m_timeHidden is 0 or less, it never hides
+        if (m_timeHidden > 0) {
+            TASK_WAIT_SECONDS(m_timeHidden);
+            m_animator->PlayAnimation(m_animShow, true);
+            TASK_WAIT_ANIMATION(m_animator);
+        }
+        m_hittable = true;
+        m_shownTime = 0;
+        while (!TakeCollision() && (m_timeHidden <= 0 || m_shownTime <= m_timeShown)) {
+            Shoot(dt);
+            TASK_YIELD();
+            m_shownTime += dt;
+        }
+        if (m_hit)
             break;
-        case DYING:
-            if (!m_animator->IsPlaying()) {
-                go->Disable();
-                go->MarkToRemove();
+        m_animator->PlayAnimation(m_animShow, false);
+        TASK_WAIT_UNTIL(TakeCollision() || !m_animator->IsPlaying());
+        m_hittable = false;
+    }
+
+    while (m_animator->IsPlaying()) {
+        go->position = go->position + Vector2D(m_animator->mirrorHorizontal ? -0.5f : 0.5f, -1);
+        TASK_YIELD();
+    }
+    m_animator->PlayAnimation(m_animDying);
+    level->GetSound(SOUND_ENEMY_DEATH)->Play(1);
+    TASK_WAIT_ANIMATION(m_animator);
+    go->Disable();
+    go->MarkToRemove();
+    TASK_END();
+}
+
+void LedderBehaviour::Shoot(float dt) {
+    if (level->GetCameraX() + WINDOW_WIDTH < go->position.x) return; // Wait to be in camera
+    if (m_burstCoolDown > 0) m_burstCoolDown -= dt;
+    if (m_coolDown > 0) m_coolDown -= dt;
+    if (m_coolDown <= 0 && (m_firedInBurst < m_burstLength || m_burstCoolDown <= 0)) {
+        auto* closestPlayer = level->GetClosestPlayer(go->position);
+        if (!closestPlayer) return;
+        if (m_showStanding or (go->position.y < closestPlayer->position.y
+                               && go->position.y > closestPlayer->position.y - 33 * PIXELS_ZOOM)) {
+            if (m_burstCoolDown <= 0) {
+                m_burstCoolDown = m_burstCoolDownTime;
+                m_firedInBurst = 0; // New burst
             }
-            break;
+            Fire();
+            m_coolDown = m_coolDownTime;
+            m_firedInBurst++;
+        }
     }
 }
 
 void LedderBehaviour::Create(Level *level, GameObject *go, float time_hidden,
                              float time_shown, float cooldown_time, bool show_standing,
                              int burst_length, float burst_cooldown, bool horizontally_precise) {
-    LevelComponent::Create(level, go);
+    LevelTask::Create(level, go);
+    SetParameters(time_hidden, time_shown, cooldown_time, show_standing, burst_length, burst_cooldown,
+            horizontally_precise);
+}
+
+void LedderBehaviour::SetParameters(float time_hidden, float time_shown, float cooldown_time, bool show_standing,
+                                    int burst_length, float burst_cooldown, bool horizontally_precise) {
     m_timeHidden = time_hidden;
     m_timeShown = time_shown;
     m_coolDownTime = cooldown_time;
@@ -142,11 +149,6 @@ void LedderBehaviour::Create(Level *level, GameObject *go, float time_hidden,
     m_horizontallyPrecise = horizontally_precise;
 }
 
-void LedderBehaviour::ChangeToState(LedderBehaviour::State state) {
-    m_state = state;
-    m_currentStateTime = 0;
-}
-
 void LedderBehaviour::Fire() {
     // Grab the bullet from the pool
     auto *bullet = level->GetEnemyBullets()->FirstAvailable();
@@ -195,17 +197,19 @@ void LedderBehaviour::Fire() {
     }
 }
 
-void LedderBehaviour::OnCollision(const CollideComponent &collider) {
-    if (m_state == SHOWN || m_state == HIDING) {
+bool LedderBehaviour::AcceptCollision(const CollideComponent &collider) {
+    if (m_hittable && !m_hit) {
         auto *bullet = collider.GetGameObject()->GetComponent<BulletBehaviour *>();
         if (bullet && !bullet->IsKilled()) {
             bullet->Kill();
 
             m_animator->PlayAnimation(m_animGoingToDie);
             go->Send(SCORE1_500);
-            ChangeToState(GOING_TO_DIE);
+            m_hit = true;
+            return true;
         }
     }
+    return false;
 }
 
 void Greeder::Create(Level *level) {
@@ -321,26 +325,34 @@ void GreederSpawner::Create(Level *level, GameObject *go, float random_interval)
     m_randomInterval = random_interval;
 }
 
-void GreederSpawner::Update(float dt) {
-    m_intervalCount -= dt;
-    if (m_intervalCount > m_randomInterval)
-        return;
-    m_intervalCount = m_randomInterval;
+void GreederSpawner::Init() {
+    Component::Init();
+    auto *timers = scene->GetTimers();
+    timers->Cancel(m_spawnTimer);
+    m_spawnTimer = timers->Schedule(0.f, [this]() { OnSpawnTimer(); });
+}
 
-    if (go->IsEnabled()) {
-        if (scene->GetCameraX() + WINDOW_WIDTH + 8 * PIXELS_ZOOM <= go->position.x) { // If the spawn is visible, avoid spawning
-            if (!m_greeder->IsEnabled()) {
-                m_greeder->position = go->position;
-                m_greeder->Init();
-                scene->AddGameObject(m_greeder, RENDERING_LAYER_ENEMIES);
-            }
-        } else {
-            go->Disable();
+void GreederSpawner::OnSpawnTimer() {
+    if (!go->IsEnabled())
+        return;
+    if (scene->GetCameraX() + WINDOW_WIDTH + 8 * PIXELS_ZOOM <= go->position.x) { // If the spawn is visible, avoid spawning
+        if (!m_greeder->IsEnabled()) {
+            m_greeder->position = go->position;
+            m_greeder->Init();
+            scene->AddGameObject(m_greeder, RENDERING_LAYER_ENEMIES);
         }
+        m_spawnTimer = scene->GetTimers()->Schedule(m_randomInterval, [this]() { OnSpawnTimer(); });
+    } else {
+        go->Disable();
     }
 }
 
+void GreederSpawner::OnGameObjectDisabled() {
+    scene->GetTimers()->Cancel(m_spawnTimer);
+}
+
 void GreederSpawner::Destroy() {
+    scene->GetTimers()->Cancel(m_spawnTimer);
     m_greeder->onRemoval = GameObject::DESTROY;
     m_greeder->MarkToRemove();
     scene->AddGameObject(m_greeder, RENDERING_LAYER_ENEMIES); // Just let the level remove it, to avoid problems
@@ -8,12 +8,23 @@
 #include <random>
 #include "../../kernel/component.h"
 #include "Player.h"
+#include "../level/level_task.h"
 
 class Ledder : public GameObject {
 public:
     void
     Create(Level* level, float time_hidden, float time_shown, float cooldown_time, bool show_standing,
            int burst_length, float burst_cooldown, bool horizontally_precise);
+
+    /**
+     * Changes the parameters given to Create, to spawn the same ledder again somewhere else.
+     * Init has to be called afterwards.
+     */
+    void Configure(float time_hidden, float time_shown, float cooldown_time, bool show_standing,
+                   int burst_length, float burst_cooldown, bool horizontally_precise);
+
+private:
+    static Box LedderBox(bool show_standing);
 };
 
 class Greeder : public GameObject {
@@ -26,79 +37,85 @@ class GreederSpawner : public Component {
 private:
     Greeder *m_greeder;
     float m_randomInterval;
-    float m_intervalCount;
+    TimerHandle m_spawnTimer;
+
+    // Spawns the greeder if it is not out already, every interval until the spawn gets on screen
+    void OnSpawnTimer();
 public:
     void Create(Level* level, GameObject* go, float random_interval);
-    void Update(float dt) override;
+    void Init() override;
+    void Update(float dt) override {}
+
+    void SetRandomInterval(float random_interval) {
+        m_randomInterval = random_interval;
+    }
+
+    void OnGameObjectDisabled() override;
 
     void Destroy() override;
 };
 
-class LedderBehaviour : public LevelComponent, public CollideComponentListener {
+class LedderBehaviour : public LevelTask {
 private:
-    enum State {
-        HIDDEN,
-        SHOWING,
-        SHOWN,
-        HIDING,
-        GOING_TO_DIE,
-        DYING
-    };
-    State m_state;
     bool m_showStanding, m_horizontallyPrecise;
-    float m_currentStateTime;
+    bool m_hittable, m_hit;
+    float m_shownTime;
     float m_timeHidden, m_timeShown, m_coolDownTime, m_coolDown, m_burstCoolDownTime, m_burstCoolDown;
     int m_firedInBurst, m_burstLength;
     int m_animShow, m_animStanding, m_animShootUp, m_animShootDown, m_animGoingToDie, m_animDying;
-    AnimationRenderer *m_animator;
+    AnimationRenderer *m_animator = nullptr;
 public:
     void
     Create(Level* level, GameObject *go, float time_hidden, float time_shown, float cooldown_time, bool show_standing,
            int burst_length, float burst_cooldown, bool horizontally_precise);
 
+    void SetParameters(float time_hidden, float time_shown, float cooldown_time, bool show_standing,
+                       int burst_length, float burst_cooldown, bool horizontally_precise);
+
     void Init() override {
-        Component::Init();
-        m_currentStateTime = 0;
+        LevelTask::Init();
         if (!m_animator) {
             m_animator = go->GetComponent<AnimationRenderer *>();
-            m_animShow = m_animator->FindAnimation("Showing");
-            m_animStanding = m_animator->FindAnimation("Standing");
-            m_animShootUp = m_animator->FindAnimation("ShootUp");
-            m_animShootDown = m_animator->FindAnimation("ShootDown");
-            m_animGoingToDie = m_animator->FindAnimation("GoingToDie");
-            m_animDying = m_animator->FindAnimation("Dying");
+            m_animShow = m_animator->FindAnimation(AnimationId("Showing"));
+            m_animStanding = m_animator->FindAnimation(AnimationId("Standing"));
+            m_animShootUp = m_animator->FindAnimation(AnimationId("ShootUp"));
+            m_animShootDown = m_animator->FindAnimation(AnimationId("ShootDown"));
+            m_animGoingToDie = m_animator->FindAnimation(AnimationId("GoingToDie"));
+            m_animDying = m_animator->FindAnimation(AnimationId("Dying"));
         }
         if (m_timeHidden > 0) {
-            m_state = HIDDEN;
             m_burstCoolDown = 0;
             m_animator->CurrentAndPause(m_animShow, true);
         } else {
-            m_state = SHOWN;
             m_burstCoolDown = 0.3; // Do not shoot immediately as it enters the screen, it feels awful
             m_animator->CurrentAndPause(m_animStanding, true);
         }
         m_coolDown = 0;
         m_firedInBurst = m_burstLength; // Wait for cooldown to be zero
+        m_hittable = m_hit = false;
     }
 
     void Fire();
 
-    void Update(float dt) override;
+protected:
+    void Run(float dt) override;
 
-    void OnCollision(const CollideComponent &collider) override;
+    // Hit by a bullet while shown or hiding
+    bool AcceptCollision(const CollideComponent &collider) override;
 
 private:
-    void ChangeToState(State state);
+    // Fires at the closest player when the cooldowns allow it
+    void Shoot(float dt);
 };
 
 class GreederBehaviour : public LevelComponent, public CollideComponentListener {
 private:
     int m_animRunning, m_animJumping, m_animDying, m_animDrowning;
-    AnimationRenderer *m_animator;
+    AnimationRenderer *m_animator = nullptr;
     bool m_isDeath;
     float m_deathFor;
     short m_direction;
-    Gravity *m_gravity;
+    Gravity *m_gravity = nullptr;
     std::random_device rd;
     std::mt19937 m_mt = std::mt19937(rd());
     std::uniform_real_distribution<float> m_random_dist = std::uniform_real_distribution<float>(0.f, 1.f);
@@ -117,10 +134,10 @@ public:
         Component::Init();
         if (!m_animator) {
             m_animator = go->GetComponent<AnimationRenderer *>();
-            m_animRunning = m_animator->FindAnimation("Running");
-            m_animJumping = m_animator->FindAnimation("Jumping");
-            m_animDrowning = m_animator->FindAnimation("Drowning");
-            m_animDying = m_animator->FindAnimation("Dying");
+            m_animRunning = m_animator->FindAnimation(AnimationId("Running"));
+            m_animJumping = m_animator->FindAnimation(AnimationId("Jumping"));
+            m_animDrowning = m_animator->FindAnimation(AnimationId("Drowning"));
+            m_animDying = m_animator->FindAnimation(AnimationId("Dying"));
         }
         if (!m_gravity) {
             m_gravity = go->GetComponent<Gravity *>();
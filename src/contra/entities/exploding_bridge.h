@@ -10,6 +10,9 @@
 #include "Player.h"
 #include "explosion.h"
 
+/**
+ * Explosion of a piece of a bridge, taken from the pool of the level (see Level::SpawnBridgeExplosion)
+ */
 class BridgeExplosion : public GameObject {
 public:
     void Create(Level *level) {
@@ -65,7 +68,7 @@ public:
         m_explodingTime = 0;
         if (!m_renderer) {
             m_renderer = go->GetComponent<AnimationRenderer *>();
-            m_animState0 = m_renderer->FindAnimation("BridgeState0");
+            m_animState0 = m_renderer->FindAnimation(AnimationId("BridgeState0"));
         }
         m_renderer->PlayAnimation(current = m_animState0, true);
     }
@@ -81,11 +84,9 @@ public:
             current++;
             m_renderer->PlayAnimation(current);
 
-            auto *exp = new BridgeExplosion();
-            exp->Create(level);
-            exp->position = go->position + Vector2D(current * m_renderer->GetCurrentAnimation().frame_h * PIXELS_ZOOM, 0);
-            exp->Init();
-            level->AddGameObject(exp, RENDERING_LAYER_BULLETS);
+            level->AddGameObject(level->SpawnBridgeExplosion(
+                    go->position + Vector2D(current * m_renderer->GetCurrentAnimation().frame_h * PIXELS_ZOOM, 0)),
+                    RENDERING_LAYER_BULLETS);
 
             level->GetSound(SOUND_EXPLOSION)->Play(1);
 
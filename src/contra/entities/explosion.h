@@ -29,6 +29,10 @@ public:
         m_hasMessage = true;
     }
 
+    void Reset() override {
+        m_hasMessage = false;
+    }
+
     void Update(float dt) override {
         if (!m_renderer->IsPlaying()) {
             go->Disable();
@@ -40,34 +44,44 @@ public:
     }
 };
 
+/**
+ * Explosion of an enemy or a bullet, taken from the explosions pool of the level (see Level::SpawnExplosion)
+ */
 class Explosion : public GameObject {
+private:
+    AnimationRenderer *m_renderer;
+    int m_animCloud, m_animBurst;
 public:
-    void Create(Level *level, const Vector2D &pos, bool cloud_explosion = true) {
+    void Create(Level *level) {
         GameObject::Create();
-        auto *renderer = new AnimationRenderer();
-        renderer->Create(level, this, level->GetSpritesheet(SPRITESHEET_ENEMIES));
-        if (cloud_explosion) {
-            renderer->AddAnimation({
-                    92, 611, 0.15, 3,
-                    30, 30, 15, 15,
-                    "Explosion", AnimationRenderer::BOUNCE_AND_STOP});
-        } else {
-            renderer->AddAnimation({
-                    186, 610, 0.15, 3,
-                    34, 34, 17, 26,
-                    "Explosion", AnimationRenderer::STOP_AND_LAST});
-        }
-        renderer->Play();
+        m_renderer = new AnimationRenderer();
+        m_renderer->Create(level, this, level->GetSpritesheet(SPRITESHEET_ENEMIES));
+        m_animCloud = m_renderer->AddAnimation({
+                92, 611, 0.15, 3,
+                30, 30, 15, 15,
+                "Cloud", AnimationRenderer::BOUNCE_AND_STOP});
+        m_animBurst = m_renderer->AddAnimation({
+                186, 610, 0.15, 3,
+                34, 34, 17, 26,
+                "Burst", AnimationRenderer::STOP_AND_LAST});
         auto *self_destroy = new DestroyOnAnimationStop();
         self_destroy->Create(level, this);
         auto *sound = new SoundEffectComponent();
         sound->Create(level, this, level->GetSound(SOUND_EXPLOSION));
 
-        AddComponent(renderer);
+        AddComponent(m_renderer);
         AddComponent(sound);
         AddComponent(self_destroy);
+        AddReceiver(level);
+    }
 
+    /**
+     * @param cloud_explosion The cloud of the enemies, otherwise the burst of the bullets
+     */
+    void Init(const Vector2D &pos, bool cloud_explosion = true) {
+        GameObject::Init();
         position = pos;
+        m_renderer->PlayAnimation(cloud_explosion ? m_animCloud : m_animBurst, true, 0);
     }
 
     void SendOnDestroy(Message message) {
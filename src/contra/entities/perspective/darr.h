@@ -73,10 +73,7 @@ public:
     }
 
     void Kill() override {
-        auto *explosion = new Explosion();
-        explosion->Create(level, go->position);
-        explosion->Init();
-        level->AddGameObject(explosion, RENDERING_LAYER_ENEMIES);
+        level->AddGameObject(level->SpawnExplosion(go->position), RENDERING_LAYER_ENEMIES);
         go->Disable();
     }
 
@@ -31,10 +31,7 @@ public:
     void Update(float dt) override {
         if (!m_animator->IsPlaying()) m_animator->PlayAnimation(1);
         if (m_gravity->IsOnFloor()) {
-            auto *explosion = new Explosion();
-            explosion->Create(level, go->position, false);
-            explosion->Init();
-            level->AddGameObject(explosion, RENDERING_LAYER_BULLETS);
+            level->AddGameObject(level->SpawnExplosion(go->position, false), RENDERING_LAYER_BULLETS);
 
             for (auto *player: level->GetPlayerControls()) {
                 if (player->GetGameObject()->position.distance(go->position) < 25 * PIXELS_ZOOM
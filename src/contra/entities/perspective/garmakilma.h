@@ -24,7 +24,7 @@ public:
         }
         if (!m_animator) {
             m_animator = GetComponent<AnimationRenderer *>();
-            m_animHit = m_animator->FindAnimation("GlowingRed");
+            m_animHit = m_animator->FindAnimation(AnimationId("GlowingRed"));
         }
     }
 
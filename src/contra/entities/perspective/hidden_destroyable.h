@@ -7,9 +7,10 @@
 
 #include "../../../components/render/AnimationRenderer.h"
 #include "../../level/level.h"
+#include "../../level/level_task.h"
 #include "../explosion.h"
 
-class HiddenDestroyableBehaviour : public LevelComponent, public Hittable {
+class HiddenDestroyableBehaviour : public LevelTask, public Hittable {
 public:
     enum State {
         DEST_STATE_CLOSED,
@@ -23,13 +24,13 @@ private:
     BoxCollider *m_collider;
     AnimationRenderer *m_animator;
     State m_state;
-    float m_stateTime;
+    bool m_opening;
     int m_animOpen, m_animGlowing, m_animGlowingClosed, m_animDead;
     float m_timeOpen;
     bool m_doesClearScreen;
 public:
     void Create(Level *scene, GameObject *go, int lives, bool does_clear_screen, float time_open) {
-        LevelComponent::Create(scene, go);
+        LevelTask::Create(scene, go);
         m_maxLives = m_lives = lives;
         m_timeOpen = time_open;
         m_doesClearScreen = does_clear_screen;
@@ -40,16 +41,16 @@ public:
     }
 
     void Init() override {
-        LevelComponent::Init();
+        LevelTask::Init();
         if (!m_collider) {
             m_collider = go->GetComponent<BoxCollider *>();
         }
         if (!m_animator) {
             m_animator = go->GetComponent<AnimationRenderer *>();
-            m_animOpen = m_animator->FindAnimation("Open");
-            m_animGlowing = m_animator->FindAnimation("Glowing");
-            m_animDead = m_animator->FindAnimation("Dead");
-            m_animGlowingClosed = m_animator->FindAnimation("GlowingClosed");
+            m_animOpen = m_animator->FindAnimation(AnimationId("Open"));
+            m_animGlowing = m_animator->FindAnimation(AnimationId("Glowing"));
+            m_animDead = m_animator->FindAnimation(AnimationId("Dead"));
+            m_animGlowingClosed = m_animator->FindAnimation(AnimationId("GlowingClosed"));
         }
         m_lives = m_maxLives;
         if (m_animOpen >= 0) {
@@ -67,37 +68,30 @@ public:
         }
     }
 
-    void Update(float dt) override {
-        switch (m_state) {
-            case DEST_STATE_CLOSED:
-            case DEST_STATE_OPEN: {
-                if (m_animOpen < 0) break;
-
-                m_stateTime += dt;
-                if (m_stateTime > (m_state == DEST_STATE_OPEN ? m_timeOpen : 2.f)) {
-                    m_stateTime = 0.f;
-                    m_animator->PlayAnimation(m_animOpen, m_state == DEST_STATE_CLOSED);
-                    m_state = DEST_STATE_OPENING_CLOSING;
-                    m_collider->Disable();
-                }
-                break;
-            }
-            case DEST_STATE_OPENING_CLOSING: {
-                if (!m_animator->IsPlaying()) {
-                    m_state = m_animator->IsGoingBackwards() ? DEST_STATE_CLOSED : DEST_STATE_OPEN;
-                    if (m_animator->IsGoingBackwards()) {
-                        if (m_animGlowingClosed >= 0) m_animator->PlayAnimation(m_animGlowingClosed);
-                        else m_animator->CurrentAndPause(m_animOpen);
-                    } else {
-                        m_animator->PlayAnimation(m_animGlowing);
-                        m_collider->Enable();
-                    }
-                }
-                break;
+    void Run(float dt) override {
+        TASK_BEGIN();
+        while (m_animOpen >= 0) {
+            TASK_WAIT_SECONDS(m_state == DEST_STATE_OPEN ? m_timeOpen : 2.f);
+            if (m_state == DEST_STATE_DEAD) break;
+
+            m_opening = m_state == DEST_STATE_CLOSED;
+            m_animator->PlayAnimation(m_animOpen, m_opening);
+            m_state = DEST_STATE_OPENING_CLOSING;
+            m_collider->Disable();
+            TASK_WAIT_UNTIL(m_state == DEST_STATE_DEAD || !m_animator->IsPlaying());
+            if (m_state == DEST_STATE_DEAD) break;
+
+            if (m_opening) {
+                m_state = DEST_STATE_OPEN;
+                m_animator->PlayAnimation(m_animGlowing);
+                m_collider->Enable();
+            } else {
+                m_state = DEST_STATE_CLOSED;
+                if (m_animGlowingClosed >= 0) m_animator->PlayAnimation(m_animGlowingClosed);
+                else m_animator->CurrentAndPause(m_animOpen);
             }
-            case DEST_STATE_DEAD:
-                break;
         }
+        TASK_END();
     }
 
     bool CanBeHit() override {
@@ -119,10 +113,7 @@ public:
         if (--m_lives <= 0) {
             m_state = DEST_STATE_DEAD;
             m_collider->Disable();
-            auto *explosion = new Explosion();
-            explosion->Create(level, go->position);
-            explosion->Init();
-            explosion->AddReceiver(level);
+            auto *explosion = level->SpawnExplosion(go->position);
             if (m_doesClearScreen) {
                 auto *persLevel = dynamic_cast<PerspectiveLevel *>(level);
                 if (persLevel) {
@@ -146,6 +137,9 @@ class HiddenDestroyableShootingKillable : public LevelComponent, public Killable
 protected:
     HiddenDestroyableBehaviour *m_destroyableBehaviour;
     float m_shootDowntime, m_untilNextShoot, m_downtimeRandFactor;
+    // Only counting down while open, what is left of it is kept in m_untilNextShoot while closed
+    TimerHandle m_shootTimer;
+    bool m_shooting;
 
     std::random_device rd;
     std::mt19937 m_mt = std::mt19937(rd());
@@ -161,23 +155,51 @@ public:
         if (!m_destroyableBehaviour) {
             m_destroyableBehaviour = GetComponent<HiddenDestroyableBehaviour *>();
         }
+        level->GetTimers()->Cancel(m_shootTimer);
+        m_shooting = false;
         m_untilNextShoot = m_shootDowntime * (1 - m_downtimeRandFactor)
                            + m_random_dist(m_mt) * m_shootDowntime * m_downtimeRandFactor;
     }
 
+    void Destroy() override {
+        level->GetTimers()->Cancel(m_shootTimer);
+        LevelComponent::Destroy();
+    }
+
     void Kill() override {
         m_destroyableBehaviour->Kill();
     }
 
     void Update(float dt) override {
-        if (m_destroyableBehaviour->GetState() == HiddenDestroyableBehaviour::DEST_STATE_OPEN) {
-            m_untilNextShoot -= dt;
-            if (m_untilNextShoot < 0) {
-                Fire();
-                m_untilNextShoot = m_shootDowntime * (1 - m_downtimeRandFactor)
-                                   + m_random_dist(m_mt) * m_shootDowntime * m_downtimeRandFactor;
-            }
+        bool open = m_destroyableBehaviour->GetState() == HiddenDestroyableBehaviour::DEST_STATE_OPEN;
+        if (open == m_shooting)
+            return;
+        m_shooting = open;
+        auto *timers = level->GetTimers();
+        if (open) {
+            m_shootTimer = timers->Schedule(m_untilNextShoot, [this]() { OnShootTimer(); });
+        } else {
+            m_untilNextShoot = timers->GetRemaining(m_shootTimer);
+            timers->Cancel(m_shootTimer);
+        }
+    }
+
+    void OnGameObjectDisabled() override {
+        level->GetTimers()->Cancel(m_shootTimer);
+        m_shooting = false;
+    }
+
+    void OnShootTimer() {
+        // Due right as it closed, before Update noticed it. Shoots as soon as it opens again.
+        if (m_destroyableBehaviour->GetState() != HiddenDestroyableBehaviour::DEST_STATE_OPEN) {
+            m_untilNextShoot = 0.f;
+            m_shooting = false;
+            return;
         }
+        Fire();
+        m_untilNextShoot = m_shootDowntime * (1 - m_downtimeRandFactor)
+                           + m_random_dist(m_mt) * m_shootDowntime * m_downtimeRandFactor;
+        m_shootTimer = level->GetTimers()->Schedule(m_untilNextShoot, [this]() { OnShootTimer(); });
     }
 
     virtual void Fire() {
@@ -15,8 +15,8 @@
 class PerspectiveLedderBehaviour : public LevelComponent, public Hittable, public Killable {
 private:
     PerspectiveLevel *m_perspectiveLevel;
-    AnimationRenderer *m_animator;
-    Gravity *m_gravity;
+    AnimationRenderer *m_animator = nullptr;
+    Gravity *m_gravity = nullptr;
     int m_duckAnim, m_jumpAnim, m_runAnim, m_standAnim, m_dyingAnim;
     bool m_goesJumping;
     bool m_shootsPills;
@@ -29,7 +29,10 @@ private:
     float m_deadFor;
     float m_cooldownMin;
     float m_cooldownMax;
-    PickUp *m_droppedPickup;
+    bool m_dropsPickup;
+    PickUpType m_pickupType;
+    // Animations of the ledder with and without the pickup, chosen on Init
+    int m_anims[2][4];
     enum MovementState {
         MOVING,
         STANDING,
@@ -41,12 +44,13 @@ private:
     std::mt19937 m_mt = std::mt19937(rd());
     std::uniform_real_distribution<float> m_random_dist = std::uniform_real_distribution<float>(0.f, 1.f);
 public:
-    void
-    Create(PerspectiveLevel *level, GameObject *go, bool jumps, bool stopToShootChance, float speed,
-           PickUp *droppedPickup, bool shoots_pills, float cooldown_min, float cooldown_max,
-           float change_direction_chance) {
+    void Create(PerspectiveLevel *level, GameObject *go) {
         LevelComponent::Create(level, go);
         m_perspectiveLevel = level;
+    }
+
+    void Configure(bool jumps, bool stopToShootChance, float speed, bool drops_pickup, PickUpType pickup_type,
+                   bool shoots_pills, float cooldown_min, float cooldown_max, float change_direction_chance) {
         m_goesJumping = jumps;
         m_shootsPills = shoots_pills;
         m_changeDirectionChance = change_direction_chance;
@@ -54,25 +58,37 @@ public:
         m_cooldownMin = cooldown_min;
         m_cooldownMax = cooldown_max;
         m_speed = speed;
-        m_droppedPickup = droppedPickup;
+        m_dropsPickup = drops_pickup;
+        m_pickupType = pickup_type;
     }
 
     void Init() override {
         LevelComponent::Init();
         if (!m_animator) {
             m_animator = GetComponent<AnimationRenderer *>();
-            m_duckAnim = m_animator->FindAnimation("Duck");
-            m_runAnim = m_animator->FindAnimation("Run");
-            m_jumpAnim = m_animator->FindAnimation("Jump");
-            m_standAnim = m_animator->FindAnimation("Stand");
-            m_dyingAnim = m_animator->FindAnimation("Dying");
+            m_anims[0][0] = m_animator->FindAnimation(AnimationId("Duck"));
+            m_anims[0][1] = m_animator->FindAnimation(AnimationId("Run"));
+            m_anims[0][2] = m_animator->FindAnimation(AnimationId("Jump"));
+            m_anims[0][3] = m_animator->FindAnimation(AnimationId("Stand"));
+            m_anims[1][0] = m_animator->FindAnimation(AnimationId("DuckCarrying"));
+            m_anims[1][1] = m_animator->FindAnimation(AnimationId("RunCarrying"));
+            m_anims[1][2] = m_animator->FindAnimation(AnimationId("JumpCarrying"));
+            m_anims[1][3] = m_animator->FindAnimation(AnimationId("StandCarrying"));
+            m_dyingAnim = m_animator->FindAnimation(AnimationId("Dying"));
         }
+        const int *anims = m_anims[m_dropsPickup ? 1 : 0];
+        m_duckAnim = anims[0];
+        m_runAnim = anims[1];
+        m_jumpAnim = anims[2];
+        m_standAnim = anims[3];
         if (!m_gravity) {
             m_gravity = GetComponent<Gravity *>();
         }
         m_state = MOVING;
         m_nextShoot = m_random_dist(m_mt);
         m_deadFor = 0;
+        m_timeOnFloor = 0;
+        m_timeStanding = 0;
         m_hasChangedDir = false;
         m_animator->mirrorHorizontal = m_speed > 0;
     }
@@ -181,21 +197,12 @@ public:
         m_animator->PlayAnimation(m_dyingAnim);
     }
 
-    void Destroy() override {
-        Component::Destroy();
-        if (m_droppedPickup) {
-            m_droppedPickup->Destroy();
-            m_droppedPickup = nullptr;
-        }
-    }
-
     void Hit() override {
         m_state = DEAD;
-        if (m_droppedPickup) {
-            m_droppedPickup->position = go->position;
-            m_droppedPickup->Init(Vector2D(0.f, 0.f));
-            level->AddGameObject(m_droppedPickup, RENDERING_LAYER_ENEMIES);
-            m_droppedPickup = nullptr;
+        if (m_dropsPickup) {
+            level->AddGameObject(m_perspectiveLevel->SpawnPickUp(m_pickupType, go->position),
+                                 RENDERING_LAYER_ENEMIES);
+            m_dropsPickup = false;
         }
     }
 
@@ -204,60 +211,80 @@ public:
     }
 };
 
+/**
+ * Ledder of the perspective levels, taken from the pool of the level and configured for each spawn
+ */
 class PerspectiveLedder : public GameObject {
+private:
+    PerspectiveLedderBehaviour *m_behaviour;
+    Gravity *m_gravity;
+    BoxCollider *m_collider;
 public:
-    void Create(PerspectiveLevel *level, bool jumps, float stopToShootChance, float speed,
-                PickUp *dropped = nullptr, bool shoots_pills = false,
-                float cooldown_min = 0.5f, float cooldown_max = 1.f,
-                float change_dir_chance = 0.f) {
+    void Create(PerspectiveLevel *level) {
         GameObject::Create();
-        auto *behaviour = new PerspectiveLedderBehaviour();
-        behaviour->Create(level, this, jumps, stopToShootChance, speed, dropped,
-                shoots_pills, cooldown_min, cooldown_max, change_dir_chance);
+        m_behaviour = new PerspectiveLedderBehaviour();
+        m_behaviour->Create(level, this);
         auto *renderer = new AnimationRenderer();
-        auto shift = dropped ? 110 : 0;
         renderer->Create(level, this, level->GetSpritesheet(SPRITESHEET_ENEMIES));
-        renderer->AddAnimation({
-                2 + shift, 423, 0.1, 1,
-                11, 19, 5, 18,
-                "Duck", AnimationRenderer::STOP_AND_FIRST
-        });
-        renderer->AddAnimation({
-                15 + shift, 428, 0.1, 1,
-                24, 14, 12, 13,
-                "Jump", AnimationRenderer::STOP_AND_FIRST
-        });
-        renderer->AddAnimation({
-                40 + shift, 417, 0.1, 3,
-                18, 25, 9, 24,
-                "Run", AnimationRenderer::DONT_STOP
-        });
-        renderer->AddAnimation({
-                95 + shift, 418, 0.1, 1,
-                15, 24, 7, 23,
-                "Stand", AnimationRenderer::DONT_STOP
-        });
+        // The ones carrying a pickup are drawn next to the others
+        for (auto shift : {0, 110}) {
+            const char *suffix = shift ? "Carrying" : "";
+            renderer->AddAnimation({
+                    2 + shift, 423, 0.1, 1,
+                    11, 19, 5, 18,
+                    std::string("Duck") + suffix, AnimationRenderer::STOP_AND_FIRST
+            });
+            renderer->AddAnimation({
+                    15 + shift, 428, 0.1, 1,
+                    24, 14, 12, 13,
+                    std::string("Jump") + suffix, AnimationRenderer::STOP_AND_FIRST
+            });
+            renderer->AddAnimation({
+                    40 + shift, 417, 0.1, 3,
+                    18, 25, 9, 24,
+                    std::string("Run") + suffix, AnimationRenderer::DONT_STOP
+            });
+            renderer->AddAnimation({
+                    95 + shift, 418, 0.1, 1,
+                    15, 24, 7, 23,
+                    std::string("Stand") + suffix, AnimationRenderer::DONT_STOP
+            });
+        }
         renderer->AddAnimation({
                 186, 610, 0.15, 3,
                 34, 34, 17, 26,
                 "Dying", AnimationRenderer::STOP_AND_LAST
         });
-        auto *gravity = new Gravity();
-        gravity->Create(level, this);
-        gravity->SetAcceleration(500 * PIXELS_ZOOM);
-        gravity->SetBaseFloor(PERSP_ENEMIES_Y * PIXELS_ZOOM);
-        auto *collider = new BoxCollider();
-        collider->Create(level, this,
-                (jumps ? -7 : -5) * PIXELS_ZOOM, (jumps ? -15 : -23) * PIXELS_ZOOM,
-                (jumps ? 14 : 9) * PIXELS_ZOOM, (jumps ? 15 : 23) * PIXELS_ZOOM,
-                NPCS_COLLISION_LAYER, -1);
+        m_gravity = new Gravity();
+        m_gravity->Create(level, this);
+        m_collider = new BoxCollider();
+        m_collider->Create(level, this, Box{0, 0, 0, 0}, NPCS_COLLISION_LAYER, -1);
 
-        AddComponent(behaviour);
-        AddComponent(gravity);
-        AddComponent(collider);
+        AddComponent(m_behaviour);
+        AddComponent(m_gravity);
+        AddComponent(m_collider);
         AddComponent(renderer);
     }
 
+    /**
+     * Sets up the ledder for its next spawn, before Init
+     */
+    void Configure(bool jumps, float stopToShootChance, float speed,
+                   bool drops_pickup = false, PickUpType pickup_type = PICKUP_MACHINE_GUN,
+                   bool shoots_pills = false, float cooldown_min = 0.5f, float cooldown_max = 1.f,
+                   float change_dir_chance = 0.f) {
+        m_behaviour->Configure(jumps, stopToShootChance, speed, drops_pickup, pickup_type,
+                shoots_pills, cooldown_min, cooldown_max, change_dir_chance);
+        // The dying ledders stop the gravity
+        m_gravity->SetAcceleration(500 * PIXELS_ZOOM);
+        m_gravity->SetBaseFloor(PERSP_ENEMIES_Y * PIXELS_ZOOM);
+        if (jumps) {
+            m_collider->ChangeBox(Box{-7, -15, 7, 0} * PIXELS_ZOOM);
+        } else {
+            m_collider->ChangeBox(Box{-5, -23, 4, 0} * PIXELS_ZOOM);
+        }
+    }
+
     void Init(const Vector2D &pos) {
         position = pos;
         GameObject::Init();
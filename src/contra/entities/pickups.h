@@ -38,6 +38,10 @@ public:
         return m_type;
     }
 
+    void SetType(PickUpType type) {
+        m_type = type;
+    }
+
     void Update(float dt) override {
         if (!m_gravity->IsOnFloor()) {
             go->position = go->position + m_speedOnAir * dt;
@@ -74,6 +78,15 @@ public:
         AddComponent(collider);
     }
 
+    /**
+     * Changes the type of a pickup taken again from a pool and throws it up as when it was created
+     */
+    void Configure(PickUpType type) {
+        GetComponent<PickUpBehaviour *>()->SetType(type);
+        GetComponent<SimpleRenderer *>()->ChangeCoords(25 * (int) type, 0, 24, 15, 12, 14);
+        GetComponent<Gravity *>()->SetVelocity(-PLAYER_JUMP * PIXELS_ZOOM);
+    }
+
     void Init(Vector2D speed_on_air = Vector2D(PICKUP_SPEED * PIXELS_ZOOM, 0)) {
         GameObject::Init();
         GetComponent<PickUpBehaviour *>()->Init(speed_on_air);
@@ -105,7 +118,7 @@ public:
     void Init() override {
         if (!m_animator) {
             m_animator = go->GetComponent<AnimationRenderer *>();
-            m_animDying = m_animator->FindAnimation("Dying");
+            m_animDying = m_animator->FindAnimation(AnimationId("Dying"));
         }
     }
 
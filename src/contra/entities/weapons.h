@@ -14,17 +14,15 @@ protected:
     Level *m_level;
     int m_playerIdx;
     float m_bulletSpeedMultiplier = 1.f;
-    SoundEffect *m_sound;
+    std::shared_ptr<SoundEffect> m_sound;
 public:
     explicit Weapon(Level *level, int player_idx, const char *sound_path = "data/sound/rifle.wav")
             : m_level(level), m_playerIdx(player_idx) {
-        m_sound = m_level->GetEngine()->createSound(sound_path);
+        // Fast weapons would fill the mixer otherwise, the oldest shot is cut instead
+        m_sound = m_level->GetEngine()->getAssets().GetSound(sound_path, 3, SOUND_PRIORITY_WEAPON);
     }
 
-    virtual ~Weapon() {
-        delete m_sound;
-        m_sound = nullptr;
-    }
+    virtual ~Weapon() = default;
 
     float GetBulletSpeedMultiplier() const {
         return m_bulletSpeedMultiplier;
@@ -177,7 +175,7 @@ private:
     float m_shootDowntime = 0;
     float m_soundTime = 0;
     bool m_soundStopped = true;
-    std::function<void()> m_currentSoundStop = []() {};
+    SoundHandle m_currentSound;
 public:
     MachineGun(Level *level, int player_idx) : Weapon(level, player_idx, "data/sound/machine_gun.wav") {}
 
@@ -185,7 +183,7 @@ public:
         m_shootDowntime -= dt;
         m_soundTime += dt;
         if (!m_soundStopped && !fireKey && m_soundTime > 0.15 && m_soundTime < 0.60) {
-            m_currentSoundStop();
+            m_sound->Stop(m_currentSound);
             m_soundStopped = true;
         }
         return fireKey && m_shootDowntime <= 0;
@@ -199,8 +197,8 @@ public:
             m_level->AddGameObject(bullet, RENDERING_LAYER_BULLETS);
             m_shootDowntime = 0.2;
             if (m_soundStopped || m_soundTime > 0.60) {
-                m_currentSoundStop();
-                m_currentSoundStop = m_sound->Play(1);
+                m_sound->Stop(m_currentSound);
+                m_currentSound = m_sound->Play(1);
                 m_soundTime = 0;
                 m_soundStopped = false;
             }
@@ -11,19 +11,25 @@ void Game::Create(AvancezLib *avancezLib) {
     this->engine = avancezLib;
     levelFactory = new LevelFactory(&spritesheets, players, &stats[0], engine);
 
-    {
-        std::shared_ptr<Sprite> ss_player(engine->createSprite("data/spritesheet.png"));
-        std::shared_ptr<Sprite> ss_enemies(engine->createSprite("data/enemies_spritesheet.png"));
-        std::shared_ptr<Sprite> ss_pickups(engine->createSprite("data/pickups.png"));
-        spritesheets.insert({SPRITESHEET_PLAYER, ss_player});
-        spritesheets.insert({SPRITESHEET_ENEMIES, ss_enemies});
-        spritesheets.insert({SPRITESHEET_PICKUPS, ss_pickups});
-    }
+    // Generated at build time by the AtlasPacker target
+    engine->loadAtlas("data/sprites.atlas");
+    AssetCache &assets = engine->getAssets();
+    spritesheets.insert({SPRITESHEET_PLAYER, assets.GetSprite("data/spritesheet.png")});
+    spritesheets.insert({SPRITESHEET_ENEMIES, assets.GetSprite("data/enemies_spritesheet.png")});
+    spritesheets.insert({SPRITESHEET_PICKUPS, assets.GetSprite("data/pickups.png")});
+    // Used by every level and menu, loaded once here instead of on each transition
+    assets.PreloadSprites({"data/main_menu/menu_spritesheet.png", "data/bridge.png"});
+    assets.PreloadMusic({"data/sound/stage_clear.wav", "data/sound/game_over.wav"});
+    // Same limits as the Weapon sounds, so picking up a weapon does not decode anything
+    assets.PreloadSounds({"data/sound/rifle.wav", "data/sound/machine_gun.wav", "data/sound/spread.wav",
+                          "data/sound/flamethrower.wav", "data/sound/laser.wav"}, 3, SOUND_PRIORITY_WEAPON);
 
     currentScene = InitMainMenu();
 }
 
 void Game::Receive(Message m) {
+    // The scenes live on the heap, the message may come from a level updating in its own arena
+    Arena::Scope heap(nullptr);
     switch (m) {
         case GO_TO_MAIN_MENU: {
             Start(InitMainMenu());
@@ -51,10 +57,8 @@ void Game::Receive(Message m) {
             } else {
                 RollbackPlayerStats(); // Restore previous score
             }
-            auto *level = levelFactory->LoadLevel("data/level" + std::to_string(current_level + 1) + "/", players);
-            level->AddReceiver(this);
-            level->Init();
-            Start(level);
+            // No introduction, the level starts as soon as it is loaded
+            StartLevel(0.f);
             break;
         }
         case NEXT_LEVEL: {
@@ -64,14 +68,7 @@ void Game::Receive(Message m) {
             memcpy(lastSavedStats, stats, sizeof(PlayerStats) * 2);
 
             if (current_level < 2) {
-                auto *level = levelFactory->LoadLevel("data/level" + std::to_string(current_level + 1) + "/", players);
-                level->AddReceiver(this);
-                auto *introduction = new PreLevel();
-                introduction->Create(engine, this);
-                introduction->Init(level);
-                introduction->AddReceiver(this);
-
-                Start(introduction);
+                StartLevel(5.f);
             } else {
                 auto *credits = new Credits();
                 credits->Create(engine, this);
@@ -138,6 +135,17 @@ void Game::Destroy() {
     delete levelFactory;
 }
 
+void Game::StartLevel(float intro_duration) {
+    // Loaded while the introduction is shown, the current scene is destroyed meanwhile
+    auto loading = levelFactory->LoadLevelAsync("data/level" + std::to_string(current_level + 1) + "/", players);
+    auto *introduction = new PreLevel();
+    introduction->Create(engine, this);
+    introduction->Init(std::move(loading), current_level + 1, intro_duration);
+    introduction->AddReceiver(this);
+
+    Start(introduction);
+}
+
 BaseScene *Game::InitMainMenu() {
     auto *menu = new MainMenu();
     menu->Create(engine, this);
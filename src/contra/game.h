@@ -114,4 +114,10 @@ public:
 
 private:
     BaseScene *InitMainMenu();
+
+    /**
+     * Loads the current level in the background and shows the stage introduction meanwhile
+     * @param intro_duration Minimum time the introduction is shown, 0 starts the level once loaded
+     */
+    void StartLevel(float intro_duration);
 };
\ No newline at end of file
@@ -7,8 +7,12 @@
 #include "yaml_converters.h"
 #include "../entities/bullets.h"
 #include "../entities/Player.h"
+#include "../entities/explosion.h"
+#include "../entities/exploding_bridge.h"
 
 void Level::Update(float dt) {
+    // What is spawned during the frame belongs to the level
+    Arena::Scope scope(&m_arena);
     BaseScene::Update(dt);
 
     if (PlayersAlive() <= 0) {
@@ -37,41 +41,83 @@ void Level::Update(float dt) {
         }
     }
 
+    if (m_engine->isDebugEnabled(DebugDraw::DEBUG_POOLS)) {
+        DrawPoolUsage();
+    }
+
     SubUpdate(dt);
 }
 
+void Level::DrawPoolUsage() {
+    char line[64];
+    int y = 24 * PIXELS_ZOOM;
+    for (int i = 0; i < players.size(); i++) {
+        snprintf(line, sizeof(line), "P%d D%u/%zu M%u/%zu S%u/%zu F%u/%zu L%u/%zu", i + 1,
+                default_bullets[i].CountEnabled(), default_bullets[i].pool.size(),
+                machine_gun_bullets[i].CountEnabled(), machine_gun_bullets[i].pool.size(),
+                spread_bullets[i].CountEnabled(), spread_bullets[i].pool.size(),
+                fire_bullets[i].CountEnabled(), fire_bullets[i].pool.size(),
+                laser_bullets[i].CountEnabled(), laser_bullets[i].pool.size());
+        m_engine->debugText(DebugDraw::DEBUG_POOLS, 0, y, line);
+        y += 10 * PIXELS_ZOOM;
+    }
+    snprintf(line, sizeof(line), "NPC %u/%zu", enemy_bullets->CountEnabled(), enemy_bullets->pool.size());
+    m_engine->debugText(DebugDraw::DEBUG_POOLS, 0, y, line);
+    y += 10 * PIXELS_ZOOM;
+    snprintf(line, sizeof(line), "EXP %u/%zu BRG %u/%zu", explosions->CountEnabled(), explosions->Size(),
+             bridge_explosions->CountEnabled(), bridge_explosions->Size());
+    m_engine->debugText(DebugDraw::DEBUG_POOLS, 0, y, line);
+    y += 10 * PIXELS_ZOOM;
+    snprintf(line, sizeof(line), "ACT %d NEAR %d SLEEP %d", m_activity.GetCount(SceneActivity::ACTIVE),
+             m_activity.GetCount(SceneActivity::NEAR), m_activity.GetCount(SceneActivity::ASLEEP));
+    m_engine->debugText(DebugDraw::DEBUG_POOLS, 0, y, line);
+}
+
 void Level::Create(const std::string &folder, const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets_map,
-                   YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *avancezLib) {
-    levelName = scene_root["name"].as<std::string>();
-    levelIndex = scene_root["number"].as<int>();
+                   const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *avancezLib) {
+    const LevelInfo &info = data.GetInfo();
+    levelName = data.GetString(info.name);
+    levelIndex = info.number;
     spritesheets = spritesheets_map;
 
-    std::string bg = folder + scene_root["background"].as<std::string>();
+    std::string bg = folder + data.GetString(info.background);
     std::string music_str;
     char *music = nullptr;
-    Vector2D animation_shift(0, 0);
-    if (scene_root["background_animation_shift"]) {
-        animation_shift = scene_root["background_animation_shift"].as<Vector2D>();
-    }
-    float animation_shift_time = 0.2f;
-    if (scene_root["background_animation_shift_time"]) {
-        animation_shift_time = scene_root["background_animation_shift_time"].as<float>();
-    }
-    if (scene_root["music"]) {
-        music_str = folder + scene_root["music"].as<std::string>();
+    Vector2D animation_shift(info.shiftX, info.shiftY);
+    if (info.music != LEVEL_NO_STRING) {
+        music_str = folder + data.GetString(info.music);
         music = music_str.data();
     }
-    BaseScene::Create(avancezLib, bg.data(), music, animation_shift, animation_shift_time);
-    levelWidth = m_background->getWidth() * PIXELS_ZOOM;
-    m_grid.Create(34 * PIXELS_ZOOM, levelWidth, WINDOW_HEIGHT);
+    std::string tiles_str;
+    char *tiles = nullptr;
+    if (info.backgroundTiles != LEVEL_NO_STRING) {
+        tiles_str = folder + data.GetString(info.backgroundTiles);
+        tiles = tiles_str.data();
+    }
+    BaseScene::Create(avancezLib, bg.data(), music, animation_shift, info.shiftTime, tiles);
+    levelWidth = GetBackgroundWidth() * PIXELS_ZOOM;
+    m_grid.Create(34 * PIXELS_ZOOM, GetGridWidth(), WINDOW_HEIGHT);
 
+    LoadAnimationSets("data/animations.yaml");
     CreateBulletPools(num_players);
     CreatePlayers(num_players, stats);
     PreloadSounds();
+    CreateExplosionPools();
 }
 
 void Level::Destroy() {
     SDL_Log("Level::Destroy");
+    BaseScene::Destroy();
+    // After the scene, which still referenced the pooled objects in use
+    DestroyPools();
+    // Frees everything created by the level at once
+    m_arena.Release();
+    animation_sets.clear();
+
+    shared_sounds.clear();
+}
+
+void Level::DestroyPools() {
     for (int i = 0; i < players.size(); i++) {
         default_bullets[i].Destroy();
         machine_gun_bullets[i].Destroy();
@@ -94,68 +140,75 @@ void Level::Destroy() {
     delete enemy_bullets;
     enemy_bullets = nullptr;
 
-    BaseScene::Destroy();
+    explosions->Destroy();
+    delete explosions;
+    explosions = nullptr;
+    bridge_explosions->Destroy();
+    delete bridge_explosions;
+    bridge_explosions = nullptr;
+}
 
-    for (auto pair: shared_sounds) {
-        delete pair.second;
-    }
+void Level::CreateExplosionPools() {
+    explosions = new PrefabPool<Explosion>();
+    explosions->Create(MAX_EXPLOSIONS, [this](Explosion *explosion) {
+        explosion->Create(this);
+    });
+    bridge_explosions = new PrefabPool<BridgeExplosion>();
+    bridge_explosions->Create(MAX_BRIDGE_EXPLOSIONS, [this](BridgeExplosion *explosion) {
+        explosion->Create(this);
+    });
 }
 
-void Level::CreateBulletPools(int num_players) {
-    // Create bullet pools for the players
-    default_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_DEFAULT_BULLETS, {
-            82, 10, 0.2, 1,
-            3, 3, 1, 1,
-            "Bullet", AnimationRenderer::STOP_AND_LAST
-    }, {-1, -1, 2, 2}, num_players);
-    machine_gun_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_MACHINE_GUN_BULLETS, {
-            89, 9, 0.2, 1,
-            5, 5, 2, 2,
-            "Bullet", AnimationRenderer::STOP_AND_LAST
-    }, {-2, -2, 2, 2}, num_players);
-    spread_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_SPREAD_BULLETS, {
-            88, 8, 0.2, 3,
-            8, 8, 4, 4,
-            "Bullet", AnimationRenderer::STOP_AND_LAST
-    }, {-2, -2, 2, 2}, num_players);
-    fire_bullets = CreatePlayersBulletPools<BulletCirclesMovement>(MAX_FIRE_BULLETS, {
-            112, 8, 0.2, 1,
-            8, 8, 4, 4,
-            "Bullet", AnimationRenderer::STOP_AND_LAST
-    }, {-2, -2, 2, 2}, num_players);
-    laser_bullets = CreatePlayersBulletPools<LaserBulletBehaviour>(MAX_LASER_BULLETS, {
-            121, 0, 0.2, 1,
-            6, 16, 3, 8,
-            "Bullet", AnimationRenderer::STOP_AND_LAST
-    }, {-3, -3, 3, 3}, num_players);
-    for (int i = 0; i < num_players; i++) {
-        for (auto *bullet: laser_bullets[i].pool) {
-            auto *renderer = bullet->GetComponent<AnimationRenderer *>();
-            renderer->AddAnimation({
-                    128, 3, 0.2, 1,
-                    8, 13, 4, 6,
-                    "BulletDiag", AnimationRenderer::STOP_AND_LAST
-            });
-            renderer->AddAnimation({
-                    136, 9, 0.2, 1,
-                    16, 6, 8, 3,
-                    "BulletHorizontal", AnimationRenderer::STOP_AND_LAST
-            });
+Explosion *Level::SpawnExplosion(const Vector2D &pos, bool cloud_explosion) {
+    auto *explosion = explosions->Acquire();
+    explosion->Init(pos, cloud_explosion);
+    return explosion;
+}
+
+BridgeExplosion *Level::SpawnBridgeExplosion(const Vector2D &pos) {
+    auto *explosion = bridge_explosions->Acquire();
+    explosion->position = pos;
+    explosion->Init();
+    return explosion;
+}
+
+void Level::LoadAnimationSets(const char *path) {
+    try {
+        YAML::Node root = YAML::LoadFile(path);
+        for (const auto &set_node: root["sets"]) {
+            auto set = std::make_shared<AnimationSet>();
+            for (const auto &animation_node: set_node.second) {
+                set->Add(animation_node.as<AnimationRenderer::Animation>());
+            }
+            animation_sets[AnimationId(set_node.first.as<std::string>().c_str())] = set;
         }
+    } catch (YAML::Exception &exception) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load animations file %s: %s", path, exception.what());
     }
+}
+
+void Level::CreateBulletPools(int num_players) {
+    // Create bullet pools for the players, all the bullets of a kind share their animations
+    default_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_DEFAULT_BULLETS,
+            GetAnimationSet(AnimationId("player_default_bullet")), {-1, -1, 2, 2}, num_players);
+    machine_gun_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_MACHINE_GUN_BULLETS,
+            GetAnimationSet(AnimationId("player_machine_gun_bullet")), {-2, -2, 2, 2}, num_players);
+    spread_bullets = CreatePlayersBulletPools<BulletStraightMovement>(MAX_SPREAD_BULLETS,
+            GetAnimationSet(AnimationId("player_spread_bullet")), {-2, -2, 2, 2}, num_players);
+    fire_bullets = CreatePlayersBulletPools<BulletCirclesMovement>(MAX_FIRE_BULLETS,
+            GetAnimationSet(AnimationId("player_fire_bullet")), {-2, -2, 2, 2}, num_players);
+    laser_bullets = CreatePlayersBulletPools<LaserBulletBehaviour>(MAX_LASER_BULLETS,
+            GetAnimationSet(AnimationId("player_laser_bullet")), {-3, -3, 3, 3}, num_players);
 
     // Create bullet pool for the npcs
     enemy_bullets = new ObjectPool<Bullet>();
     enemy_bullets->Create(MAX_NPC_BULLETS);
+    auto enemy_bullet_animations = GetAnimationSet(AnimationId("enemy_bullet"));
     for (auto *bullet: enemy_bullets->pool) {
         bullet->Create();
         auto *renderer = new AnimationRenderer();
         renderer->Create(this, bullet, GetSpritesheet(SPRITESHEET_ENEMIES));
-        renderer->AddAnimation({
-                199, 72, 0.2, 1,
-                3, 3, 1, 1,
-                "Bullet", AnimationRenderer::STOP_AND_LAST
-        });
+        renderer->SetAnimationSet(enemy_bullet_animations);
         auto *behaviour = new BulletStraightMovement();
         behaviour->Create(this, bullet);
         auto *box_collider = new BoxCollider();
@@ -176,7 +229,7 @@ void Level::Init() {
     complete = false;
 
     for (const auto &layer: game_objects) {
-        for (auto game_object : *layer)
+        for (auto game_object : layer)
             game_object->Init();
     }
 
@@ -186,7 +239,7 @@ void Level::Init() {
 void Level::CreatePlayers(short num_players, PlayerStats *stats) {
     for (short i = 0; i < num_players; i++) {
         auto *player = CreatePlayer(i, &stats[i]);
-        game_objects[RENDERING_LAYER_PLAYER]->insert(player);
+        game_objects[RENDERING_LAYER_PLAYER].Insert(player);
         players.push_back(player);
         auto *playerControl = player->GetComponent<PlayerControl *>();
         playerControls.push_back(playerControl);
@@ -194,7 +247,8 @@ void Level::CreatePlayers(short num_players, PlayerStats *stats) {
 }
 
 template<typename T>
-ObjectPool <Bullet> *Level::CreatePlayersBulletPools(int num_bullets, const AnimationRenderer::Animation &animation,
+ObjectPool <Bullet> *Level::CreatePlayersBulletPools(int num_bullets,
+                                                     const std::shared_ptr<const AnimationSet> &animations,
                                                      const Box &box, int num_players) {
     auto *pools = new ObjectPool<Bullet>[num_players]();
     for (auto *pool = pools; pool < pools + num_players; pool++) {
@@ -203,12 +257,7 @@ ObjectPool <Bullet> *Level::CreatePlayersBulletPools(int num_bullets, const Anim
             bullet->Create();
             auto *renderer = new AnimationRenderer();
             renderer->Create(this, bullet, GetSpritesheet(SPRITESHEET_PLAYER));
-            renderer->AddAnimation(animation);
-            renderer->AddAnimation({
-                    104, 0, 0.1, 1,
-                    7, 7, 3, 3,
-                    "Kill", AnimationRenderer::STOP_AND_FIRST
-            });
+            renderer->SetAnimationSet(animations);
             renderer->Play();
             auto *behaviour = new T();
             behaviour->Create(this, bullet);
@@ -337,12 +386,19 @@ float Level::PlayersTopY(bool *alive_players) const {
 }
 
 void Level::PreloadSounds() {
-    shared_sounds.insert({SOUND_ENEMY_DEATH, m_engine->createSound("data/sound/enemy_death.wav")});
-    shared_sounds.insert({SOUND_ENEMY_HIT, m_engine->createSound("data/sound/enemy_hit.wav")});
-    shared_sounds.insert({SOUND_PLAYER_DEATH, m_engine->createSound("data/sound/death.wav")});
-    shared_sounds.insert({SOUND_EXPLOSION, m_engine->createSound("data/sound/explosion.wav")});
-    shared_sounds.insert({SOUND_PICKUP, m_engine->createSound("data/sound/pickup.wav")});
-    mus_stage_clear.reset(m_engine->createMusic("data/sound/stage_clear.wav"));
+    // Already decoded if a previous level used them
+    AssetCache &assets = m_engine->getAssets();
+    shared_sounds.insert({SOUND_ENEMY_DEATH, assets.GetSound("data/sound/enemy_death.wav",
+            4, SOUND_PRIORITY_ENEMY)});
+    shared_sounds.insert({SOUND_ENEMY_HIT, assets.GetSound("data/sound/enemy_hit.wav",
+            2, SOUND_PRIORITY_HIT)});
+    shared_sounds.insert({SOUND_PLAYER_DEATH, assets.GetSound("data/sound/death.wav",
+            2, SOUND_PRIORITY_PLAYER)});
+    shared_sounds.insert({SOUND_EXPLOSION, assets.GetSound("data/sound/explosion.wav",
+            3, SOUND_PRIORITY_EXPLOSION)});
+    shared_sounds.insert({SOUND_PICKUP, assets.GetSound("data/sound/pickup.wav",
+            2, SOUND_PRIORITY_PLAYER)});
+    mus_stage_clear = assets.GetMusic("data/sound/stage_clear.wav");
 }
 
 float Level::GetTimeSinceComplete() {
@@ -15,11 +15,15 @@
 #include "../../consts.h"
 #include "../../components/collision/grid.h"
 #include "../../kernel/object_pool.h"
+#include "../../kernel/prefab_pool.h"
+#include "../../kernel/arena.h"
 #include "../../components/render/AnimationRenderer.h"
+#include "../../components/render/AnimationSet.h"
 #include "../entities/pickup_types.h"
 #include "../../components/scene.h"
 #include "../player_stats.h"
 #include "yaml_converters.h"
+#include "level_data.h"
 
 class Player;
 
@@ -31,30 +35,41 @@ class Bullet;
 
 class PickUpHolderBehaviour;
 
+class Explosion;
+
+class BridgeExplosion;
+
 class Level : public BaseScene {
 protected:
-    std::unordered_map<int, SoundEffect *> shared_sounds;
+    std::unordered_map<int, std::shared_ptr<SoundEffect>> shared_sounds;
     const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets;
     std::shared_ptr<Sprite> bridge_sprite;
     std::shared_ptr<Floor> level_floor;
-    std::unique_ptr<Music> mus_stage_clear;
+    std::shared_ptr<Music> mus_stage_clear;
     std::vector<Player *> players;
     std::vector<PlayerControl *> playerControls;
+    /** Animations shared by the objects of the level, by AnimationId of the set name */
+    std::unordered_map<Uint32, std::shared_ptr<const AnimationSet>> animation_sets;
     // All the player bullet pools are arrays, the enemy_bullets is just one object pool
     ObjectPool<Bullet> *default_bullets, *fire_bullets,
             *machine_gun_bullets, *spread_bullets, *laser_bullets, *enemy_bullets;
+    // The explosions are the most frequent short lived objects, they are reused instead of created each time
+    PrefabPool<Explosion> *explosions;
+    PrefabPool<BridgeExplosion> *bridge_explosions;
     bool complete;
     float completeTime;
     std::string levelName;
     int levelIndex;
     int levelWidth;
+    // Holds the game objects and components of the level, see GetArena
+    Arena m_arena;
 
     std::random_device rd;
     std::mt19937 m_mt = std::mt19937(rd());
     std::uniform_real_distribution<float> m_random_dist = std::uniform_real_distribution<float>(0.f, 1.f);
 public:
     virtual void Create(const std::string &folder, const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets,
-                        YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *engine);
+                        const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *engine);
 
     void Init() override;
 
@@ -72,19 +87,27 @@ public:
      */
     std::shared_ptr<Sprite> GetBridgeSprite() {
         if (!bridge_sprite) {
-            bridge_sprite = std::shared_ptr<Sprite>(m_engine->createSprite("data/bridge.png"));
+            bridge_sprite = m_engine->getAssets().GetSprite("data/bridge.png");
         }
         return bridge_sprite;
     }
 
     void Destroy() override;
 
+    /**
+     * Arena of the objects of the level, it has to be the current one (see Arena::Scope) while the level
+     * is created or initialized from outside, Update already does it
+     */
+    Arena *GetArena() {
+        return &m_arena;
+    }
+
     /**
      * Gets the specified sound from the preloaded sound effects. Use the SOUND_* macros
      * to get the different IDs.
      */
     SoundEffect *GetSound(int id) const {
-        return shared_sounds.at(id);
+        return shared_sounds.at(id).get();
     }
 
     /**
@@ -95,6 +118,19 @@ public:
         return spritesheets->at(id);
     }
 
+    /**
+     * Gets the animation set with the given AnimationId of its name in data/animations.yaml,
+     * an empty set if it does not exist.
+     */
+    std::shared_ptr<const AnimationSet> GetAnimationSet(Uint32 id) const {
+        auto it = animation_sets.find(id);
+        if (it == animation_sets.end()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Level::GetAnimationSet: Unknown animation set %u", id);
+            return std::make_shared<const AnimationSet>();
+        }
+        return it->second;
+    }
+
     const std::weak_ptr<Floor> GetLevelFloor() const {
         return level_floor;
     }
@@ -189,6 +225,17 @@ public:
         return enemy_bullets;
     }
 
+    /**
+     * Takes an explosion from the pool and initializes it, it still has to be added to the level
+     * @param cloud_explosion The cloud of the enemies, otherwise the burst of the bullets
+     */
+    Explosion *SpawnExplosion(const Vector2D &pos, bool cloud_explosion = true);
+
+    /**
+     * Takes a bridge explosion from the pool and initializes it, it still has to be added to the level
+     */
+    BridgeExplosion *SpawnBridgeExplosion(const Vector2D &pos);
+
     void Receive(Message m) override;
 
     const std::string &GetLevelName() const;
@@ -218,23 +265,33 @@ public:
         return playerControls;
     }
 
+protected:
+    /** Destroys the pools of the level, once the scene does not reference their objects */
+    virtual void DestroyPools();
+
 private:
     /** Creates the bullet pools for the game */
     void CreateBulletPools(int num_players);
+    /** Creates the pools of the explosions */
+    void CreateExplosionPools();
     /** Preloads the necessary sound effects */
     void PreloadSounds();
+    /** Loads the shared animation sets listed in the file */
+    void LoadAnimationSets(const char *path);
+    /** Debug overlay with the bullets in use of each pool */
+    void DrawPoolUsage();
 
     /**
      * Creates bullet pools for all the players with the desired configuration
      * @tparam T the behaviour component to use, should be an extension of BulletBehaviour
      * @param num_bullets Number of bullets in the pool
-     * @param animation Bullet main animation configuration
+     * @param animations Bullet animations, with at least "Bullet" and "Kill"
      * @param box Box for the bullet box collider
      * @param num_players Number of players
      * @return
      */
     template<typename T>
-    ObjectPool<Bullet> *CreatePlayersBulletPools(int num_bullets, const AnimationRenderer::Animation &animation,
+    ObjectPool<Bullet> *CreatePlayersBulletPools(int num_bullets, const std::shared_ptr<const AnimationSet> &animations,
                                                  const Box &box, int num_players);
 
     /** Creates the players for the level */
@@ -249,6 +306,12 @@ protected:
      * updates.
      */
     virtual void SubUpdate(float dt) = 0;
+
+    /** Width of the columns of the collision grid, which wrap around if the level is wider */
+    [[nodiscard]] virtual int GetGridWidth() const {
+        return levelWidth;
+    }
+
     int m_playerBulletsCollisionLayer = NPCS_COLLISION_LAYER, m_playerBulletsCollisionCheckLayer = -1,
             m_enemyBulletsCollisionLayer = PLAYER_COLLISION_LAYER, m_enemyBulletsCollisionCheckLayer = -1;
 };
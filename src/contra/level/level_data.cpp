@@ -0,0 +1,472 @@
+#include "level_data.h"
+#include <cstring>
+#include "../entities/pickup_types.h"
+
+namespace {
+    enum FieldType {
+        FIELD_INT,
+        FIELD_FLOAT,
+        FIELD_BOOL,
+        FIELD_STRING,
+        FIELD_VECTOR, // [x, y]
+        FIELD_PICKUP, // M, F, R, L, S or B
+        FIELD_ENTRANCE, // left or right
+        FIELD_LEVEL_TYPE, // S or P
+        FIELD_RECORDS, // Sequence of maps with the given fields
+        FIELD_MAP // Map with the given fields
+    };
+
+    /** Schema of a field of a map, the lists of fields end with an empty name */
+    struct FieldSchema {
+        const char *name;
+        FieldType type;
+        bool required;
+        const FieldSchema *fields;
+    };
+
+    const FieldSchema POSITION_FIELDS[] = {
+            {"pos", FIELD_VECTOR, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema ROTATING_CANON_FIELDS[] = {
+            {"pos", FIELD_VECTOR, true, nullptr},
+            {"burst_length", FIELD_INT, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema LEDDER_FIELDS[] = {
+            {"pos", FIELD_VECTOR, true, nullptr},
+            {"time_hidden", FIELD_FLOAT, true, nullptr},
+            {"time_shown", FIELD_FLOAT, true, nullptr},
+            {"cooldown_time", FIELD_FLOAT, true, nullptr},
+            {"show_standing", FIELD_BOOL, true, nullptr},
+            {"burst_length", FIELD_INT, true, nullptr},
+            {"burst_cooldown", FIELD_FLOAT, true, nullptr},
+            {"horizontally_precise", FIELD_BOOL, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema GREEDER_FIELDS[] = {
+            {"pos", FIELD_VECTOR, true, nullptr},
+            {"chance_skip", FIELD_FLOAT, false, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema PICKUP_FIELDS[] = {
+            {"pos", FIELD_VECTOR, true, nullptr},
+            {"content", FIELD_PICKUP, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema PATTERN_SPAWN_FIELDS[] = {
+            {"jumps", FIELD_BOOL, false, nullptr},
+            {"stop_to_shoot_prob", FIELD_FLOAT, false, nullptr},
+            {"change_dir_prob", FIELD_FLOAT, false, nullptr},
+            {"speed_factor", FIELD_FLOAT, false, nullptr},
+            {"pickup", FIELD_PICKUP, false, nullptr},
+            {"shoots_pills", FIELD_BOOL, false, nullptr},
+            {"cooldown_min", FIELD_FLOAT, false, nullptr},
+            {"cooldown_max", FIELD_FLOAT, false, nullptr},
+            {"entrance", FIELD_ENTRANCE, true, nullptr},
+            {"secs_next", FIELD_FLOAT, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema DARRS_FIELDS[] = {
+            {"start", FIELD_FLOAT, true, nullptr},
+            {"interval", FIELD_FLOAT, true, nullptr},
+            {nullptr}
+    };
+
+    const FieldSchema SPAWN_PATTERN_FIELDS[] = {
+            {"pretime", FIELD_FLOAT, true, nullptr},
+            {"darrs", FIELD_MAP, false, DARRS_FIELDS},
+            {"pattern", FIELD_RECORDS, true, PATTERN_SPAWN_FIELDS},
+            {nullptr}
+    };
+
+    const FieldSchema LEVEL_FIELDS[] = {
+            {"level_type", FIELD_LEVEL_TYPE, true, nullptr},
+            {"number", FIELD_INT, true, nullptr},
+            {"name", FIELD_STRING, true, nullptr},
+            {"music", FIELD_STRING, false, nullptr},
+            {"boss_music", FIELD_STRING, false, nullptr},
+            {"background", FIELD_STRING, true, nullptr},
+            {"background_animation_shift", FIELD_VECTOR, false, nullptr},
+            {"background_animation_shift_time", FIELD_FLOAT, false, nullptr},
+            {"background_tiles", FIELD_STRING, false, nullptr},
+            {"floor_mask", FIELD_STRING, false, nullptr},
+            {"screens", FIELD_INT, false, nullptr},
+            {"rotating_canons", FIELD_RECORDS, false, ROTATING_CANON_FIELDS},
+            {"gulcans", FIELD_RECORDS, false, POSITION_FIELDS},
+            {"ledders", FIELD_RECORDS, false, LEDDER_FIELDS},
+            {"greeders", FIELD_RECORDS, false, GREEDER_FIELDS},
+            {"covered_pickups", FIELD_RECORDS, false, PICKUP_FIELDS},
+            {"flying_pickups", FIELD_RECORDS, false, PICKUP_FIELDS},
+            {"exploding_bridges", FIELD_RECORDS, false, POSITION_FIELDS},
+            {"weak_cores", FIELD_RECORDS, false, POSITION_FIELDS},
+            {"strong_cores", FIELD_RECORDS, false, POSITION_FIELDS},
+            {"core_canons", FIELD_RECORDS, false, POSITION_FIELDS},
+            {"spawn_patterns", FIELD_RECORDS, false, SPAWN_PATTERN_FIELDS},
+            {nullptr}
+    };
+
+    // Size of the records of each LevelSection, to check the ranges of a loaded file
+    const size_t RECORD_SIZES[LEVEL_SECTION_COUNT] = {
+            sizeof(RotatingCanonRecord), sizeof(PositionRecord), sizeof(LedderRecord), sizeof(GreederRecord),
+            sizeof(PickUpRecord), sizeof(PickUpRecord), sizeof(PositionRecord), sizeof(PositionRecord),
+            sizeof(PositionRecord), sizeof(PositionRecord), sizeof(SpawnPatternRecord), sizeof(PatternSpawnRecord)
+    };
+
+    int ParsePickUp(const std::string &value) {
+        switch (value.empty() ? ' ' : value[0]) {
+            case 'M':
+                return PICKUP_MACHINE_GUN;
+            case 'F':
+                return PICKUP_FIRE_GUN;
+            case 'R':
+                return PICKUP_RAPID_FIRE;
+            case 'L':
+                return PICKUP_LASER;
+            case 'S':
+                return PICKUP_SPREAD;
+            case 'B':
+                return PICKUP_BARRIER;
+            default:
+                return -1;
+        }
+    }
+
+    bool IsValidValue(const YAML::Node &node, FieldType type) {
+        try {
+            switch (type) {
+                case FIELD_INT:
+                    node.as<int>();
+                    return true;
+                case FIELD_FLOAT:
+                    node.as<float>();
+                    return true;
+                case FIELD_BOOL:
+                    node.as<bool>();
+                    return true;
+                case FIELD_STRING:
+                    return node.IsScalar();
+                case FIELD_VECTOR:
+                    if (!node.IsSequence() || node.size() != 2)
+                        return false;
+                    node[0].as<float>();
+                    node[1].as<float>();
+                    return true;
+                case FIELD_PICKUP:
+                    return node.IsScalar() && ParsePickUp(node.as<std::string>()) >= 0;
+                case FIELD_ENTRANCE:
+                    return node.IsScalar() && (node.as<std::string>() == "left" || node.as<std::string>() == "right");
+                case FIELD_LEVEL_TYPE:
+                    return node.IsScalar() && (node.as<std::string>() == "S" || node.as<std::string>() == "P");
+                case FIELD_RECORDS:
+                    return node.IsSequence();
+                case FIELD_MAP:
+                    return node.IsMap();
+            }
+        } catch (YAML::Exception &exception) {
+            return false;
+        }
+        return false;
+    }
+
+    void Validate(const YAML::Node &node, const FieldSchema *fields, const std::string &path,
+                  std::vector<std::string> &errors) {
+        if (!node.IsMap()) {
+            errors.push_back(path + ": expected a map");
+            return;
+        }
+        for (const auto &entry : node) {
+            const auto key = entry.first.as<std::string>();
+            const FieldSchema *field = fields;
+            while (field->name && key != field->name)
+                field++;
+            if (!field->name)
+                errors.push_back(path + "." + key + ": unknown field");
+        }
+        for (const FieldSchema *field = fields; field->name; field++) {
+            const std::string field_path = path + "." + field->name;
+            const YAML::Node value = node[field->name];
+            if (!value) {
+                if (field->required)
+                    errors.push_back(field_path + ": missing");
+                continue;
+            }
+            if (!IsValidValue(value, field->type)) {
+                errors.push_back(field_path + ": invalid value");
+                continue;
+            }
+            if (field->type == FIELD_RECORDS) {
+                for (size_t i = 0; i < value.size(); i++)
+                    Validate(value[i], field->fields, field_path + "[" + std::to_string(i) + "]", errors);
+            } else if (field->type == FIELD_MAP) {
+                Validate(value, field->fields, field_path, errors);
+            }
+        }
+    }
+
+    float GetFloat(const YAML::Node &node, const char *key, float default_value) {
+        return node[key] ? node[key].as<float>() : default_value;
+    }
+
+    bool GetBool(const YAML::Node &node, const char *key) {
+        return node[key] && node[key].as<bool>();
+    }
+
+    /** Lays out the file, the sections are appended in the order of LevelSection */
+    class LevelWriter {
+    public:
+        LevelWriter() : m_header(), m_bytes(sizeof(LevelFileHeader), 0) {}
+
+        LevelFileHeader &Header() {
+            return m_header;
+        }
+
+        Uint32 AddString(const YAML::Node &node) {
+            if (!node)
+                return LEVEL_NO_STRING;
+            const auto value = node.as<std::string>();
+            auto offset = Uint32(m_strings.size());
+            m_strings.insert(m_strings.end(), value.begin(), value.end());
+            m_strings.push_back('\0');
+            return offset;
+        }
+
+        template<class T>
+        void AddSection(LevelSection section, const std::vector<T> &records) {
+            static_assert(sizeof(T) % 4 == 0, "Records have to keep the sections aligned");
+            auto offset = Uint32(m_bytes.size());
+            m_bytes.resize(m_bytes.size() + records.size() * sizeof(T));
+            if (!records.empty())
+                memcpy(m_bytes.data() + offset, records.data(), records.size() * sizeof(T));
+            m_header.sections[section] = {offset, Uint32(records.size())};
+        }
+
+        std::vector<Uint8> Finish(Uint32 source_hash) {
+            memcpy(m_header.magic, LevelData::MAGIC, 4);
+            m_header.version = LevelData::VERSION;
+            m_header.sectionCount = LEVEL_SECTION_COUNT;
+            m_header.sourceHash = source_hash;
+            m_header.stringsOffset = Uint32(m_bytes.size());
+            m_header.stringsSize = Uint32(m_strings.size());
+            m_bytes.insert(m_bytes.end(), m_strings.begin(), m_strings.end());
+            m_header.size = Uint32(m_bytes.size());
+            memcpy(m_bytes.data(), &m_header, sizeof(LevelFileHeader));
+            return std::move(m_bytes);
+        }
+
+    private:
+        LevelFileHeader m_header;
+        std::vector<Uint8> m_bytes;
+        std::vector<char> m_strings;
+    };
+
+    std::vector<PositionRecord> ReadPositions(const YAML::Node &nodes) {
+        std::vector<PositionRecord> records;
+        for (const auto &node : nodes)
+            records.push_back({node["pos"][0].as<float>(), node["pos"][1].as<float>()});
+        return records;
+    }
+
+    std::vector<PickUpRecord> ReadPickUps(const YAML::Node &nodes) {
+        std::vector<PickUpRecord> records;
+        for (const auto &node : nodes) {
+            records.push_back({node["pos"][0].as<float>(), node["pos"][1].as<float>(),
+                               ParsePickUp(node["content"].as<std::string>())});
+        }
+        return records;
+    }
+}
+
+bool LevelData::Compile(const YAML::Node &root, Uint32 source_hash, std::vector<std::string> &errors) {
+    Validate(root, LEVEL_FIELDS, "level", errors);
+    if (errors.empty()) {
+        const bool scrolling = root["level_type"].as<std::string>() == "S";
+        if (scrolling && !root["floor_mask"])
+            errors.emplace_back("level.floor_mask: missing, required by scrolling levels");
+        if (!scrolling && !root["screens"])
+            errors.emplace_back("level.screens: missing, required by perspective levels");
+        if (!scrolling && !root["boss_music"])
+            errors.emplace_back("level.boss_music: missing, required by perspective levels");
+    }
+    if (!errors.empty())
+        return false;
+
+    LevelWriter writer;
+    LevelInfo &info = writer.Header().info;
+    info.type = Uint8(root["level_type"].as<std::string>()[0]);
+    info.number = root["number"].as<int>();
+    info.name = writer.AddString(root["name"]);
+    info.music = writer.AddString(root["music"]);
+    info.bossMusic = writer.AddString(root["boss_music"]);
+    info.background = writer.AddString(root["background"]);
+    info.backgroundTiles = writer.AddString(root["background_tiles"]);
+    info.floorMask = writer.AddString(root["floor_mask"]);
+    if (root["background_animation_shift"]) {
+        info.shiftX = root["background_animation_shift"][0].as<float>();
+        info.shiftY = root["background_animation_shift"][1].as<float>();
+    }
+    info.shiftTime = GetFloat(root, "background_animation_shift_time", 0.2f);
+    info.screens = root["screens"] ? root["screens"].as<int>() : 0;
+
+    std::vector<RotatingCanonRecord> canons;
+    for (const auto &node : root["rotating_canons"]) {
+        canons.push_back({node["pos"][0].as<float>(), node["pos"][1].as<float>(), node["burst_length"].as<int>()});
+    }
+    writer.AddSection(LEVEL_ROTATING_CANONS, canons);
+    writer.AddSection(LEVEL_GULCANS, ReadPositions(root["gulcans"]));
+
+    std::vector<LedderRecord> ledders;
+    for (const auto &node : root["ledders"]) {
+        LedderRecord ledder = {};
+        ledder.x = node["pos"][0].as<float>();
+        ledder.y = node["pos"][1].as<float>();
+        ledder.timeHidden = node["time_hidden"].as<float>();
+        ledder.timeShown = node["time_shown"].as<float>();
+        ledder.cooldownTime = node["cooldown_time"].as<float>();
+        ledder.burstCooldown = node["burst_cooldown"].as<float>();
+        ledder.burstLength = node["burst_length"].as<int>();
+        ledder.showStanding = node["show_standing"].as<bool>();
+        ledder.horizontallyPrecise = node["horizontally_precise"].as<bool>();
+        ledders.push_back(ledder);
+    }
+    writer.AddSection(LEVEL_LEDDERS, ledders);
+
+    std::vector<GreederRecord> greeders;
+    for (const auto &node : root["greeders"]) {
+        greeders.push_back({node["pos"][0].as<float>(), node["pos"][1].as<float>(), GetFloat(node, "chance_skip", 0.f)});
+    }
+    writer.AddSection(LEVEL_GREEDERS, greeders);
+    writer.AddSection(LEVEL_COVERED_PICKUPS, ReadPickUps(root["covered_pickups"]));
+    writer.AddSection(LEVEL_FLYING_PICKUPS, ReadPickUps(root["flying_pickups"]));
+    writer.AddSection(LEVEL_EXPLODING_BRIDGES, ReadPositions(root["exploding_bridges"]));
+    writer.AddSection(LEVEL_WEAK_CORES, ReadPositions(root["weak_cores"]));
+    writer.AddSection(LEVEL_STRONG_CORES, ReadPositions(root["strong_cores"]));
+    writer.AddSection(LEVEL_CORE_CANONS, ReadPositions(root["core_canons"]));
+
+    std::vector<SpawnPatternRecord> patterns;
+    std::vector<PatternSpawnRecord> spawns;
+    for (const auto &pattern_node : root["spawn_patterns"]) {
+        SpawnPatternRecord pattern = {};
+        pattern.pretime = pattern_node["pretime"].as<float>();
+        pattern.darrsStart = pattern_node["darrs"] ? pattern_node["darrs"]["start"].as<float>() : -1.f;
+        pattern.darrsInterval = pattern_node["darrs"] ? pattern_node["darrs"]["interval"].as<float>() : -1.f;
+        pattern.firstSpawn = Uint32(spawns.size());
+        for (const auto &node : pattern_node["pattern"]) {
+            PatternSpawnRecord spawn = {};
+            spawn.jumps = GetBool(node, "jumps");
+            spawn.stopToShootChance = GetFloat(node, "stop_to_shoot_prob", 0.f);
+            spawn.changeDirectionChance = GetFloat(node, "change_dir_prob", 0.f);
+            spawn.speedFactor = GetFloat(node, "speed_factor", spawn.jumps ? 0.5f : 1.f);
+            spawn.pickup = node["pickup"] ? ParsePickUp(node["pickup"].as<std::string>()) : -1;
+            spawn.shootsPills = GetBool(node, "shoots_pills");
+            spawn.cooldownMin = GetFloat(node, "cooldown_min", 0.5f);
+            spawn.cooldownMax = GetFloat(node, "cooldown_max", 1.f);
+            spawn.enterFromRight = node["entrance"].as<std::string>() == "right";
+            if (spawn.enterFromRight)
+                spawn.speedFactor *= -1;
+            spawn.secsUntilNext = node["secs_next"].as<float>();
+            spawns.push_back(spawn);
+        }
+        pattern.spawnCount = Uint32(spawns.size()) - pattern.firstSpawn;
+        patterns.push_back(pattern);
+    }
+    writer.AddSection(LEVEL_SPAWN_PATTERNS, patterns);
+    writer.AddSection(LEVEL_PATTERN_SPAWNS, spawns);
+
+    m_bytes = writer.Finish(source_hash);
+    return true;
+}
+
+bool LevelData::Load(const std::string &folder) {
+    const std::string base = folder.empty() || folder.back() == '/' ? folder : folder + '/';
+    std::vector<Uint8> source;
+    const bool has_source = ReadFile(base + "level.yaml", source);
+    const Uint32 source_hash = has_source ? HashSource(source.data(), source.size()) : 0;
+
+    if (ReadFile(base + "level.bin", m_bytes)) {
+        if (IsValid(source_hash, has_source))
+            return true;
+        SDL_Log("%slevel.bin is outdated or from another version, using level.yaml", base.c_str());
+    }
+    m_bytes.clear();
+    if (!has_source) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load level file: %slevel.yaml", base.c_str());
+        return false;
+    }
+
+    std::vector<std::string> errors;
+    try {
+        YAML::Node root = YAML::Load(std::string(source.begin(), source.end()));
+        Compile(root, source_hash, errors);
+    } catch (YAML::Exception &exception) {
+        errors.emplace_back(exception.what());
+    }
+    for (const auto &error : errors)
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%slevel.yaml: %s", base.c_str(), error.c_str());
+    return errors.empty();
+}
+
+const char *LevelData::GetString(Uint32 offset) const {
+    const LevelFileHeader &header = Header();
+    if (offset >= header.stringsSize)
+        return nullptr;
+    return reinterpret_cast<const char *>(m_bytes.data() + header.stringsOffset + offset);
+}
+
+Uint32 LevelData::HashSource(const void *data, size_t size) {
+    Uint32 hash = 2166136261u;
+    const auto *bytes = static_cast<const Uint8 *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool LevelData::ReadFile(const std::string &path, std::vector<Uint8> &bytes) {
+    SDL_RWops *file = SDL_RWFromFile(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    Sint64 size = SDL_RWsize(file);
+    bool ok = size >= 0;
+    if (ok) {
+        bytes.resize(size_t(size));
+        ok = size == 0 || SDL_RWread(file, bytes.data(), size_t(size), 1) == 1;
+    }
+    SDL_RWclose(file);
+    return ok;
+}
+
+bool LevelData::IsValid(Uint32 source_hash, bool check_hash) const {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    return false; // Records are read in place, compiled from level.yaml instead
+#else
+    if (m_bytes.size() < sizeof(LevelFileHeader))
+        return false;
+    const LevelFileHeader &header = Header();
+    if (memcmp(header.magic, MAGIC, 4) != 0 || header.version != VERSION ||
+        header.sectionCount != LEVEL_SECTION_COUNT || header.size != m_bytes.size())
+        return false;
+    if (check_hash && header.sourceHash != source_hash)
+        return false;
+    for (int i = 0; i < LEVEL_SECTION_COUNT; i++) {
+        const LevelSectionRange &range = header.sections[i];
+        if (range.offset % 4 != 0 || range.offset > m_bytes.size() ||
+            range.count > (m_bytes.size() - range.offset) / RECORD_SIZES[i])
+            return false;
+    }
+    for (const auto &pattern : GetRecords<SpawnPatternRecord>(LEVEL_SPAWN_PATTERNS)) {
+        if (pattern.firstSpawn > header.sections[LEVEL_PATTERN_SPAWNS].count ||
+            pattern.spawnCount > header.sections[LEVEL_PATTERN_SPAWNS].count - pattern.firstSpawn)
+            return false;
+    }
+    return header.stringsOffset <= m_bytes.size() && header.stringsSize <= m_bytes.size() - header.stringsOffset &&
+           (header.stringsSize == 0 || m_bytes[header.stringsOffset + header.stringsSize - 1] == '\0');
+#endif
+}
@@ -0,0 +1,197 @@
+#ifndef CONTRA_LEVEL_DATA_H
+#define CONTRA_LEVEL_DATA_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+/*
+ * Compiled level format (level.bin), written by tools/level_compiler.cpp from the level.yaml of each
+ * level folder. The file is a LevelFileHeader followed by the records of each section and a table of
+ * null terminated strings. All the records are 4 bytes aligned and read in place, so the format is
+ * little endian and only loaded as is on little endian machines.
+ */
+
+const Uint32 LEVEL_NO_STRING = 0xFFFFFFFF;
+
+enum LevelSection {
+    LEVEL_ROTATING_CANONS,
+    LEVEL_GULCANS,
+    LEVEL_LEDDERS,
+    LEVEL_GREEDERS,
+    LEVEL_COVERED_PICKUPS,
+    LEVEL_FLYING_PICKUPS,
+    LEVEL_EXPLODING_BRIDGES,
+    LEVEL_WEAK_CORES,
+    LEVEL_STRONG_CORES,
+    LEVEL_CORE_CANONS,
+    LEVEL_SPAWN_PATTERNS,
+    LEVEL_PATTERN_SPAWNS, // The spawns of all the patterns, each pattern has a range of them
+    LEVEL_SECTION_COUNT
+};
+
+/** Values of the level root, positions are in level pixels and strings are offsets in the string table */
+struct LevelInfo {
+    Uint8 type; // 'S' scrolling or 'P' perspective
+    Uint8 padding[3];
+    Sint32 number;
+    Uint32 name;
+    Uint32 music;
+    Uint32 bossMusic;
+    Uint32 background;
+    Uint32 backgroundTiles;
+    Uint32 floorMask;
+    float shiftX;
+    float shiftY;
+    float shiftTime;
+    Sint32 screens;
+};
+
+struct LevelSectionRange {
+    Uint32 offset; // From the start of the file
+    Uint32 count;
+};
+
+struct LevelFileHeader {
+    char magic[4];
+    Uint16 version;
+    Uint16 sectionCount;
+    Uint32 size; // Of the whole file, to detect truncated files
+    Uint32 sourceHash; // FNV-1a of the level.yaml compiled, to detect outdated files
+    Uint32 stringsOffset;
+    Uint32 stringsSize;
+    LevelInfo info;
+    LevelSectionRange sections[LEVEL_SECTION_COUNT];
+};
+
+// gulcans, exploding_bridges, weak_cores, strong_cores and core_canons
+struct PositionRecord {
+    float x, y;
+};
+
+struct RotatingCanonRecord {
+    float x, y;
+    Sint32 burstLength;
+};
+
+struct LedderRecord {
+    float x, y;
+    float timeHidden;
+    float timeShown;
+    float cooldownTime;
+    float burstCooldown;
+    Sint32 burstLength;
+    Uint8 showStanding;
+    Uint8 horizontallyPrecise;
+    Uint8 padding[2];
+};
+
+struct GreederRecord {
+    float x, y;
+    float chanceSkip; // 0 if it always spawns
+};
+
+struct PickUpRecord {
+    float x, y;
+    Sint32 content; // PickUpType
+};
+
+struct SpawnPatternRecord {
+    float pretime;
+    float darrsStart; // -1 without darrs
+    float darrsInterval;
+    Uint32 firstSpawn; // In LEVEL_PATTERN_SPAWNS
+    Uint32 spawnCount;
+};
+
+struct PatternSpawnRecord {
+    float stopToShootChance;
+    float changeDirectionChance;
+    float speedFactor; // Already negative for the spawns entering from the right
+    float cooldownMin;
+    float cooldownMax;
+    float secsUntilNext;
+    Sint32 pickup; // PickUpType, -1 if nothing is dropped
+    Uint8 jumps;
+    Uint8 shootsPills;
+    Uint8 enterFromRight;
+    Uint8 padding;
+};
+
+/**
+ * Read only view of the records of a section, pointing into the loaded file
+ */
+template<class T>
+struct LevelRecords {
+    const T *records = nullptr;
+    Uint32 count = 0;
+
+    [[nodiscard]] const T *begin() const { return records; }
+
+    [[nodiscard]] const T *end() const { return records + count; }
+
+    [[nodiscard]] Uint32 size() const { return count; }
+
+    const T &operator[](Uint32 index) const { return records[index]; }
+};
+
+/**
+ * The content of a level folder. The compiled level.bin is loaded with a single read and the
+ * records are used where they are, nothing is parsed nor allocated per object. If there is no
+ * level.bin, or it is outdated or from another version, the level.yaml is compiled in memory
+ * instead, so YAML stays the authoring format and can be edited without rebuilding.
+ */
+class LevelData {
+public:
+    static constexpr const char *MAGIC = "CLVL";
+    static constexpr Uint16 VERSION = 1;
+
+    /**
+     * Loads folder/level.bin, or compiles folder/level.yaml if the binary can not be used
+     * @return False if neither could be loaded, the errors are logged
+     */
+    bool Load(const std::string &folder);
+
+    /**
+     * Validates the level against the schema and builds the compiled file in memory
+     * @param errors One line per problem found, the level is only compiled if there is none
+     * @return True if the level is valid
+     */
+    bool Compile(const YAML::Node &root, Uint32 source_hash, std::vector<std::string> &errors);
+
+    // The compiled file, i.e. to be written by the level compiler
+    [[nodiscard]] const std::vector<Uint8> &GetBytes() const {
+        return m_bytes;
+    }
+
+    [[nodiscard]] const LevelInfo &GetInfo() const {
+        return Header().info;
+    }
+
+    // The string at the offset of the string table, nullptr for LEVEL_NO_STRING
+    [[nodiscard]] const char *GetString(Uint32 offset) const;
+
+    template<class T>
+    [[nodiscard]] LevelRecords<T> GetRecords(LevelSection section) const {
+        const LevelSectionRange &range = Header().sections[section];
+        return {reinterpret_cast<const T *>(m_bytes.data() + range.offset), range.count};
+    }
+
+    static Uint32 HashSource(const void *data, size_t size);
+
+private:
+    // Loads the whole file, returns false if it can not be read
+    static bool ReadFile(const std::string &path, std::vector<Uint8> &bytes);
+
+    // Checks the header and the ranges of the sections and strings against the size of the file
+    bool IsValid(Uint32 source_hash, bool check_hash) const;
+
+    [[nodiscard]] const LevelFileHeader &Header() const {
+        return *reinterpret_cast<const LevelFileHeader *>(m_bytes.data());
+    }
+
+    std::vector<Uint8> m_bytes;
+};
+
+#endif //CONTRA_LEVEL_DATA_H
@@ -5,9 +5,10 @@
 #ifndef CONTRA_LEVEL_FACTORY_H
 #define CONTRA_LEVEL_FACTORY_H
 
+#include <future>
 #include <string>
 #include <memory>
-#include <yaml-cpp/yaml.h>
+#include "level_data.h"
 #include "scrolling_level.h"
 #include "perspective_level.h"
 
@@ -24,37 +25,60 @@ public:
                  PlayerStats *stats, AvancezLib *engine) : spritesheets(spritesheets),
                                                            stats(stats), engine(engine) {}
 
+    /**
+     * @return The level, or nullptr if it could not be loaded (i.e. missing files or parse errors)
+     */
     Level *LoadLevel(const std::string &folder, short num_players) {
         SDL_Log("LevelLoader::LoadLevel(%s, %d players)", &folder[0], num_players);
         Level *level = nullptr;
         try {
-            YAML::Node scene_root = YAML::LoadFile(folder + "/level.yaml");
-            if (scene_root["level_type"]) {
-                char level_type = scene_root["level_type"].as<char>();
-                switch (level_type) {
-                    case 'S': {
-                        level = new ScrollingLevel();
-                        level->Create(folder, spritesheets, scene_root, num_players, stats, engine);
-                        break;
-                    }
-                    case 'P': {
-                        level = new PerspectiveLevel();
-                        level->Create(folder, spritesheets, scene_root, num_players, stats, engine);
-                        break;
-                    }
-                    default:
-                        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognised level type '%c'", level_type);
-                        break;
+            // Compiled level.bin if up to date, else level.yaml
+            LevelData data;
+            if (!data.Load(folder))
+                return nullptr;
+            char level_type = char(data.GetInfo().type);
+            switch (level_type) {
+                case 'S': {
+                    level = new ScrollingLevel();
+                    Arena::Scope scope(level->GetArena());
+                    level->Create(folder, spritesheets, data, num_players, stats, engine);
+                    break;
                 }
-            } else {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                        "Invalid level '%s/level.yaml', no level_type found.", &folder[0]);
+                case 'P': {
+                    level = new PerspectiveLevel();
+                    Arena::Scope scope(level->GetArena());
+                    level->Create(folder, spritesheets, data, num_players, stats, engine);
+                    break;
+                }
+                default:
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unrecognised level type '%c'", level_type);
+                    break;
             }
-        } catch (YAML::BadFile &exception) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load level file: %s/level.yaml", &folder[0]);
+        } catch (const std::exception &e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LevelLoader::LoadLevel(%s): %s", &folder[0], e.what());
+            delete level; // Partially built, its arena frees what it had created
+            return nullptr;
         }
         return level;
     }
+
+    /**
+     * Loads the level in a separated thread, so the current scene keeps running meanwhile. The level
+     * textures are sent to the render backend a few per frame once decoded.
+     * @return The level, or nullptr if it could not be loaded, once ready. It has to be destroyed
+     * by whoever gets it, even if it is never started.
+     */
+    std::future<Level *> LoadLevelAsync(const std::string &folder, short num_players) {
+        return std::async(std::launch::async, [this, folder, num_players]() -> Level * {
+            // Anything thrown would be rethrown by the future on the main thread
+            try {
+                return LoadLevel(folder, num_players);
+            } catch (...) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LevelLoader::LoadLevelAsync(%s) failed", &folder[0]);
+                return nullptr;
+            }
+        });
+    }
 };
 
 #endif //CONTRA_LEVEL_FACTORY_H
@@ -0,0 +1,117 @@
+#ifndef CONTRA_LEVEL_TASK_H
+#define CONTRA_LEVEL_TASK_H
+
+#include "level_component.h"
+#include "../entities/Player.h"
+#include "../../components/collision/CollideComponent.h"
+
+/**
+ * Behaviour written as a sequence of steps which wait for things to happen, instead of a state machine
+ * switching on its state every frame.
+ *
+ * Run is a stackless coroutine built with the TASK_ macros: each wait returns from it remembering where,
+ * and the next frame it resumes right after the wait. As it resumes through a switch, Run can not have
+ * locals living across a wait, whatever has to survive one is kept in members. The frame of the coroutine
+ * is therefore the component itself, created once with its object and reused with it from the level pools,
+ * so spawning does not allocate.
+ *
+ * While waiting for time it is not run at all, a timer of the level resumes it. The other waits check
+ * their condition once per frame. Init starts it again from the beginning.
+ */
+class LevelTask : public LevelComponent, public CollideComponentListener {
+public:
+    void Init() override {
+        LevelComponent::Init();
+        Restart();
+    }
+
+    void Reset() override {
+        Restart();
+    }
+
+    void Update(float dt) override {
+        if (m_sleeping || m_resumePoint < 0)
+            return;
+        Run(dt);
+    }
+
+    void OnCollision(const CollideComponent &collider) override {
+        if (AcceptCollision(collider))
+            m_collided = true;
+    }
+
+    void Destroy() override {
+        level->GetTimers()->Cancel(m_wakeTimer);
+        LevelComponent::Destroy();
+    }
+
+    [[nodiscard]] bool IsFinished() const {
+        return m_resumePoint < 0;
+    }
+
+protected:
+    /** The steps of the behaviour, between TASK_BEGIN and TASK_END */
+    virtual void Run(float dt) = 0;
+
+    /**
+     * Called on each collision of the collider listened to, the ones accepted resume TASK_WAIT_COLLISION.
+     * They are reacted to here, as the other collider may be gone once the task resumes.
+     */
+    virtual bool AcceptCollision(const CollideComponent &collider) {
+        return true;
+    }
+
+    // Whether a collision has been accepted since the last time it was taken
+    bool TakeCollision() {
+        bool collided = m_collided;
+        m_collided = false;
+        return collided;
+    }
+
+    [[nodiscard]] bool IsPlayerInRange(float range) const {
+        auto *player = level->GetClosestPlayer(go->position);
+        return player && (player->position - go->position).magnitudeSqr() <= double(range) * range;
+    }
+
+    // Used by TASK_WAIT_SECONDS
+    void Sleep(float seconds) {
+        m_sleeping = true;
+        m_wakeTimer = level->GetTimers()->Schedule(seconds, [this]() {
+            m_sleeping = false;
+        });
+    }
+
+    int m_resumePoint = 0; // Line of the wait to resume from, -1 once finished
+
+private:
+    void Restart() {
+        level->GetTimers()->Cancel(m_wakeTimer);
+        m_sleeping = false;
+        m_collided = false;
+        m_resumePoint = 0;
+    }
+
+    TimerHandle m_wakeTimer;
+    bool m_sleeping = false;
+    bool m_collided = false;
+};
+
+#define TASK_BEGIN() switch (m_resumePoint) { case 0:
+
+// Suspends until the next frame
+#define TASK_YIELD() do { m_resumePoint = __LINE__; return; case __LINE__:; } while (0)
+
+// Checks the condition now and then once per frame, going on as soon as it holds
+#define TASK_WAIT_UNTIL(condition) do { m_resumePoint = __LINE__; case __LINE__: if (!(condition)) return; } while (0)
+
+#define TASK_WAIT_SECONDS(seconds) do { Sleep(seconds); m_resumePoint = __LINE__; return; case __LINE__:; } while (0)
+
+#define TASK_WAIT_ANIMATION(animator) TASK_WAIT_UNTIL(!(animator)->IsPlaying())
+
+#define TASK_WAIT_PLAYER_IN_RANGE(range) TASK_WAIT_UNTIL(IsPlayerInRange(range))
+
+#define TASK_WAIT_COLLISION() TASK_WAIT_UNTIL(TakeCollision())
+
+#define TASK_END() } m_resumePoint = -1
+
+#endif //CONTRA_LEVEL_TASK_H
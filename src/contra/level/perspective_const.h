@@ -13,6 +13,11 @@
 #define PERSP_BOSS_PLAYER_Y 208
 #define PERSP_ENEMIES_MARGINS 95
 
+// Initial sizes of the pools of the enemies spawned during the screens
+#define PERSP_MAX_DARRS 10
+#define PERSP_MAX_LEDDERS 6
+#define PERSP_MAX_PICKUPS 2
+
 // The following constants are used to project bullet targets
 #define PERSP_FRONT_X_START 40
 #define PERSP_FRONT_X_RANGE (WINDOW_WIDTH / PIXELS_ZOOM - 2 * PERSP_FRONT_X_START)
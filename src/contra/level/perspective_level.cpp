@@ -8,85 +8,77 @@
 #include "../entities/perspective/pers_enemies.h"
 #include "../entities/perspective/darr.h"
 #include "../entities/perspective/garmakilma.h"
-
-namespace YAML {
-    template<>
-    struct convert<PerspectiveLedderSpawn> {
-        static bool decode(const Node &node, PerspectiveLedderSpawn &rhs) {
-            rhs.jumps = node["jumps"] && node["jumps"].as<bool>();
-            rhs.stopToShootChance = node["stop_to_shoot_prob"] ? node["stop_to_shoot_prob"].as<float>() : 0.f;
-            rhs.changeDirectionChance = node["change_dir_prob"] ? node["change_dir_prob"].as<float>() : 0.f;
-            rhs.speedFactor = node["speed_factor"] ? node["speed_factor"].as<float>() : (rhs.jumps ? 0.5 : 1.0);
-            if (node["pickup"]) {
-                rhs.pickupToDrop = node["pickup"].as<PickUpType>();
-                rhs.doesDrop = true;
-            } else {
-                rhs.doesDrop = false;
-            }
-            rhs.shootsPills = node["shoots_pills"] && node["shoots_pills"].as<bool>();
-            rhs.cooldownMin = node["cooldown_min"] ? node["cooldown_min"].as<float>() : 0.5f;
-            rhs.cooldownMax = node["cooldown_max"] ? node["cooldown_max"].as<float>() : 1.f;
-            rhs.entrance = node["entrance"].as<std::string>() == "right" ? PerspectiveLedderSpawn::RIGHT
-                                                                         : PerspectiveLedderSpawn::LEFT;
-            if (rhs.entrance == PerspectiveLedderSpawn::RIGHT) {
-                rhs.speedFactor *= -1;
-            }
-            rhs.secsUntilNext = node["secs_next"].as<float>();
-            rhs.timesUsed = 0;
-            return true;
-        }
-    };
-
-    template<>
-    struct convert<DarrSpawn> {
-        static bool decode(const Node &node, DarrSpawn &rhs) {
-            rhs.start = node["start"].as<float>();
-            rhs.interval = node["interval"].as<float>();
-            return true;
-        }
-    };
-}
+#include "../entities/pickups.h"
 
 void PerspectiveLevel::Create(const std::string &folder,
                               const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets,
-                              YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *engine) {
-    Level::Create(folder, spritesheets, scene_root, num_players, stats, engine);
-    m_screenCount = scene_root["screens"].as<int>();
-    for (const auto &rc_node: scene_root["weak_cores"]) {
+                              const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *engine) {
+    Level::Create(folder, spritesheets, data, num_players, stats, engine);
+    m_screenCount = data.GetInfo().screens;
+    for (const auto &record: data.GetRecords<PositionRecord>(LEVEL_WEAK_CORES)) {
+        Vector2D position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
         auto *core = new WeakCore();
-        core->Create(this, rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM);
+        core->Create(this, ToScreenLocal(position));
         core->AddReceiver(this);
-        AddToScreens(core);
+        AddToScreens(core, ScreenOf(position));
     }
-    for (const auto &rc_node: scene_root["strong_cores"]) {
+    for (const auto &record: data.GetRecords<PositionRecord>(LEVEL_STRONG_CORES)) {
+        Vector2D position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
         auto *core = new StrongCore();
-        core->Create(this, rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM);
+        core->Create(this, ToScreenLocal(position));
         core->AddReceiver(this);
-        AddToScreens(core);
+        AddToScreens(core, ScreenOf(position));
     }
-    for (const auto &rc_node: scene_root["core_canons"]) {
+    for (const auto &record: data.GetRecords<PositionRecord>(LEVEL_CORE_CANONS)) {
+        Vector2D position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
         auto *canon = new CoreCannon();
-        canon->Create(this, rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM);
+        canon->Create(this, ToScreenLocal(position));
         canon->AddReceiver(this);
-        AddToScreens(canon);
+        AddToScreens(canon, ScreenOf(position));
     }
-    auto spawn_patterns = scene_root["spawn_patterns"];
-    for (int i = 0; i < spawn_patterns.size(); i++) {
+    auto spawn_patterns = data.GetRecords<SpawnPatternRecord>(LEVEL_SPAWN_PATTERNS);
+    auto spawns = data.GetRecords<PatternSpawnRecord>(LEVEL_PATTERN_SPAWNS);
+    for (Uint32 i = 0; i < spawn_patterns.size(); i++) {
+        const SpawnPatternRecord &record = spawn_patterns[i];
         std::vector<PerspectiveLedderSpawn> pattern;
-        float pretime = spawn_patterns[i]["pretime"].as<float>();
-        m_pretimes.insert({i, pretime});
-        if (spawn_patterns[i]["darrs"]) {
-            m_darrs.insert({i, spawn_patterns[i]["darrs"].as<DarrSpawn>()});
-        } else {
-            m_darrs.insert({i, {-1.f, -1.f}});
-        }
-        for (const auto &spawn_node: spawn_patterns[i]["pattern"]) {
-            pattern.push_back(spawn_node.as<PerspectiveLedderSpawn>());
+        pattern.reserve(record.spawnCount);
+        m_pretimes.insert({int(i), record.pretime});
+        m_darrs.insert({int(i), {record.darrsStart, record.darrsInterval}});
+        for (Uint32 j = record.firstSpawn; j < record.firstSpawn + record.spawnCount; j++) {
+            const PatternSpawnRecord &spawn = spawns[j];
+            PerspectiveLedderSpawn ledder_spawn{};
+            ledder_spawn.jumps = spawn.jumps;
+            ledder_spawn.stopToShootChance = spawn.stopToShootChance;
+            ledder_spawn.changeDirectionChance = spawn.changeDirectionChance;
+            ledder_spawn.speedFactor = spawn.speedFactor;
+            ledder_spawn.doesDrop = spawn.pickup >= 0;
+            ledder_spawn.pickupToDrop = spawn.pickup >= 0 ? PickUpType(spawn.pickup) : PICKUP_MACHINE_GUN;
+            ledder_spawn.entrance = spawn.enterFromRight ? PerspectiveLedderSpawn::RIGHT : PerspectiveLedderSpawn::LEFT;
+            ledder_spawn.shootsPills = spawn.shootsPills;
+            ledder_spawn.cooldownMin = spawn.cooldownMin;
+            ledder_spawn.cooldownMax = spawn.cooldownMax;
+            ledder_spawn.secsUntilNext = spawn.secsUntilNext;
+            ledder_spawn.timesUsed = 0;
+            pattern.push_back(ledder_spawn);
         }
         m_spawnPatterns.insert({i, pattern});
     }
-    std::string boss_music_path = folder + scene_root["boss_music"].as<std::string>();
-    m_bossMusic = m_engine->createMusic(boss_music_path.data());
+    std::string boss_music_path = folder + data.GetString(data.GetInfo().bossMusic);
+    m_bossMusic = m_engine->getAssets().GetMusic(boss_music_path);
+
+    m_darrPool = new PrefabPool<Darr>();
+    m_darrPool->Create(PERSP_MAX_DARRS, [this](Darr *darr) {
+        darr->Create(this);
+    });
+    m_ledderPool = new PrefabPool<PerspectiveLedder>();
+    m_ledderPool->Create(PERSP_MAX_LEDDERS, [this](PerspectiveLedder *ledder) {
+        ledder->Create(this);
+    });
+    m_pickupPool = new PrefabPool<PickUp>();
+    m_pickupPool->Create(PERSP_MAX_PICKUPS, [this](PickUp *pickup) {
+        pickup->Create(this, GetSpritesheet(SPRITESHEET_PICKUPS), &m_grid, level_floor, PICKUP_MACHINE_GUN,
+                PERSP_PLAYER_Y * PIXELS_ZOOM);
+    });
 }
 
 void PerspectiveLevel::Init() {
@@ -128,10 +120,7 @@ void PerspectiveLevel::Receive(Message m) {
                     Vector2D(104, 102),
                     Vector2D(151, 102)
             }) {
-                auto *explosion = new Explosion();
-                explosion->Create(this, m_camera + pos * PIXELS_ZOOM);
-                explosion->Init();
-                AddGameObject(explosion, RENDERING_LAYER_ENEMIES);
+                AddGameObject(SpawnExplosion(m_camera + pos * PIXELS_ZOOM), RENDERING_LAYER_ENEMIES);
             }
         }
     } else {
@@ -148,17 +137,14 @@ void PerspectiveLevel::SubUpdate(float dt) {
         }
     }
 
+    // The objects are local to the screen, changing screen only moves the background under them
     float new_x = (m_onTransition < 0 ? m_currentScreen + 4 : m_onTransition) *
                   WINDOW_WIDTH;  // The first 4 are the transitions
-    if (abs(new_x - m_camera.x) > 0.001) {
-        for (auto *layer = game_objects; layer != game_objects + RENDERING_LAYERS; layer++) {
-            for (auto *game_object: **layer)
-                game_object->position.x = game_object->position.x - m_camera.x + new_x;
-        }
+    if (abs(new_x - m_origin.x) > 0.001) {
         if (m_onTransition < 0) {
             InitScreen();
         }
-        m_camera = Vector2D(new_x, 0);
+        m_origin = Vector2D(new_x, 0);
     }
 
     if (m_onTransition >= 0) {
@@ -175,18 +161,6 @@ void PerspectiveLevel::SubUpdate(float dt) {
                 m_laserOn = true;
             }
         }
-    } else if (m_spawnPatterns.count(m_currentScreen) > 0) {
-        m_nextSpawn -= dt;
-        while (m_nextSpawn <= 0.f) {
-            m_nextSpawn = SpawnLedders();
-        }
-        if (m_nextDarrs > 0) {
-            m_nextDarrs -= dt;
-            if (m_nextDarrs <= 0) {
-                SpawnDarrs();
-                m_nextDarrs = m_darrs[m_currentScreen].interval;
-            }
-        }
     }
 }
 
@@ -201,14 +175,20 @@ void PerspectiveLevel::InitScreen() {
     }
 
     m_currentSpawn = -1;
-    if (m_pretimes.count(m_currentScreen) > 1) {
-        m_nextSpawn = m_pretimes[m_currentScreen];
-    } else {
-        m_nextSpawn = 1.f;
-    }
-    m_nextDarrs = m_darrs[m_currentScreen].start;
     m_nextDarrsStart = 1;
     m_nextDarrsEnd = 5;
+    if (m_spawnPatterns.count(m_currentScreen) > 0) {
+        float first_spawn;
+        if (m_pretimes.count(m_currentScreen) > 1) {
+            first_spawn = m_pretimes[m_currentScreen];
+        } else {
+            first_spawn = 1.f;
+        }
+        m_leddersTimer = m_timers.Schedule(first_spawn, [this]() { OnLeddersTimer(); });
+        if (m_darrs[m_currentScreen].start > 0) {
+            m_darrsTimer = m_timers.Schedule(m_darrs[m_currentScreen].start, [this]() { OnDarrsTimer(); });
+        }
+    }
 
     for (auto *go: m_screens[m_currentScreen]) {
         go->Init();
@@ -219,7 +199,7 @@ void PerspectiveLevel::InitScreen() {
 
     if (IsInBossBattle()) {
         auto *boss = new Garmakilma();
-        boss->Create(this, Vector2D((m_currentScreen + 4) * WINDOW_WIDTH, 0) + Vector2D(64, 24) * PIXELS_ZOOM);
+        boss->Create(this, Vector2D(64, 24) * PIXELS_ZOOM);
         boss->Init();
         AddGameObject(boss, RENDERING_LAYER_BRIDGES);
         m_onScreen.insert(boss);
@@ -237,10 +217,17 @@ void PerspectiveLevel::KillScreen() {
 }
 
 void PerspectiveLevel::ClearScreen() {
+    m_timers.Cancel(m_leddersTimer);
+    m_timers.Cancel(m_darrsTimer);
     for (auto *go: m_onScreen) {
+        // The pools only hand again the disabled objects
+        if (go->onRemoval == GameObject::DO_NOT_DESTROY)
+            go->Disable();
         go->MarkToRemove();
     }
     m_onScreen.clear();
+    // Otherwise the next screen grows the pools instead of reusing them
+    SDL_assert(m_ledderPool->CountEnabled() == 0 && m_darrPool->CountEnabled() == 0);
     if (m_currentScreen > 4) {
         m_engine->FadeOutMusic(1.f);
     }
@@ -263,33 +250,46 @@ void PerspectiveLevel::Destroy() {
         }
     }
     m_screens.clear();
-    if (m_bossMusic) {
-        delete m_bossMusic;
-    }
+    m_onScreen.clear();
+    m_bossMusic.reset();
     Level::Destroy();
 }
 
+void PerspectiveLevel::DestroyPools() {
+    Level::DestroyPools();
+    m_darrPool->Destroy();
+    delete m_darrPool;
+    m_darrPool = nullptr;
+    m_ledderPool->Destroy();
+    delete m_ledderPool;
+    m_ledderPool = nullptr;
+    m_pickupPool->Destroy();
+    delete m_pickupPool;
+    m_pickupPool = nullptr;
+}
+
+PickUp *PerspectiveLevel::SpawnPickUp(PickUpType type, const Vector2D &pos) {
+    auto *pickup = m_pickupPool->Acquire();
+    pickup->Configure(type);
+    pickup->position = pos;
+    pickup->Init(Vector2D(0.f, 0.f));
+    return pickup;
+}
+
 float PerspectiveLevel::SpawnLedders() {
     auto &screen_pattern = m_spawnPatterns[m_currentScreen];
     m_currentSpawn = (m_currentSpawn + 1) % screen_pattern.size();
     auto *spawn = &screen_pattern[m_currentSpawn];
 
-    PickUp *pickUp = nullptr;
-    if (spawn->doesDrop && spawn->timesUsed == 0) {
-        pickUp = new PickUp();
-        pickUp->Create(this, GetSpritesheet(SPRITESHEET_PICKUPS), &m_grid,
-                level_floor, spawn->pickupToDrop,
-                PERSP_PLAYER_Y * PIXELS_ZOOM);
-    }
-    auto *ledder = new PerspectiveLedder();
-    ledder->Create(this, spawn->jumps, spawn->stopToShootChance,
+    auto *ledder = m_ledderPool->Acquire();
+    ledder->Configure(spawn->jumps, spawn->stopToShootChance,
             spawn->speedFactor * PLAYER_SPEED * PIXELS_ZOOM,
-            pickUp, spawn->shootsPills, spawn->cooldownMin, spawn->cooldownMax,
+            spawn->doesDrop && spawn->timesUsed == 0, spawn->pickupToDrop,
+            spawn->shootsPills, spawn->cooldownMin, spawn->cooldownMax,
             spawn->changeDirectionChance);
     float x_pos = spawn->entrance == PerspectiveLedderSpawn::LEFT ?
                   PERSP_ENEMIES_MARGINS * PIXELS_ZOOM : WINDOW_WIDTH - PERSP_ENEMIES_MARGINS * PIXELS_ZOOM;
-    ledder->Init(Vector2D((m_currentScreen + 4) * WINDOW_WIDTH + x_pos,
-            PERSP_ENEMIES_Y * PIXELS_ZOOM));
+    ledder->Init(Vector2D(x_pos, PERSP_ENEMIES_Y * PIXELS_ZOOM));
     AddGameObject(ledder, RENDERING_LAYER_ENEMIES);
     m_onScreen.insert(ledder);
 
@@ -297,12 +297,26 @@ float PerspectiveLevel::SpawnLedders() {
     return spawn->secsUntilNext;
 }
 
+void PerspectiveLevel::OnLeddersTimer() {
+    float next_spawn;
+    do {
+        next_spawn = SpawnLedders();
+    } while (next_spawn <= 0.f);
+    m_leddersTimer = m_timers.Schedule(next_spawn, [this]() { OnLeddersTimer(); });
+}
+
+void PerspectiveLevel::OnDarrsTimer() {
+    SpawnDarrs();
+    if (m_darrs[m_currentScreen].interval > 0) {
+        m_darrsTimer = m_timers.Schedule(m_darrs[m_currentScreen].interval, [this]() { OnDarrsTimer(); });
+    }
+}
+
 void PerspectiveLevel::SpawnDarrs() {
     const int total = 6;
     const int extra_margin = 10;
     for (int i = m_nextDarrsStart; i <= m_nextDarrsEnd; i++) {
-        auto *darr = new Darr();
-        darr->Create(this);
+        auto *darr = m_darrPool->Acquire();
         Vector2D pos = Vector2D(
                 (PERSP_ENEMIES_MARGINS + extra_margin) * PIXELS_ZOOM
                 + ((WINDOW_WIDTH - (PERSP_ENEMIES_MARGINS + extra_margin) * 2 * PIXELS_ZOOM) /
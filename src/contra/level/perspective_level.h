@@ -9,6 +9,12 @@
 #include "../hittable.h"
 #include "perspective_const.h"
 
+class Darr;
+
+class PerspectiveLedder;
+
+class PickUp;
+
 struct PerspectiveLedderSpawn {
     enum Entrance {
         LEFT, RIGHT
@@ -45,7 +51,7 @@ public:
     }
 
     void Create(const std::string &folder, const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets,
-                YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *engine) override;
+                const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *engine) override;
 
     void Init() override;
 
@@ -103,25 +109,45 @@ public:
         }
     }
 
-    /** Adds the given game object to its correspondent screen based on its game object position */
-    void AddToScreens(GameObject *object) {
-        int screen_idx = floor(object->position.x / WINDOW_WIDTH) - 4; // First 4 are the transition screens
+    /** Screen of a position in level coordinates, the first 4 are the transition screens */
+    static int ScreenOf(const Vector2D &level_position) {
+        return int(floor(level_position.x / WINDOW_WIDTH)) - 4;
+    }
+
+    /** Converts a position in level coordinates to the coordinates of its screen, used by all the objects */
+    static Vector2D ToScreenLocal(const Vector2D &level_position) {
+        return Vector2D(level_position.x - float((ScreenOf(level_position) + 4) * WINDOW_WIDTH), level_position.y);
+    }
 
-        std::vector<GameObject *> *screen = nullptr;
-        if (m_screens.count(screen_idx) == 0) {
-            m_screens.insert({screen_idx, {object}});
-        } else {
-            m_screens[screen_idx].push_back(object);
-        }
+    /**
+     * Takes a pickup from the pool, thrown up from the given position, it still has to be added to the level
+     */
+    PickUp *SpawnPickUp(PickUpType type, const Vector2D &pos);
+
+    /** Adds the given game object, positioned in screen coordinates, to the objects of the screen */
+    void AddToScreens(GameObject *object, int screen_idx) {
+        m_screens[screen_idx].push_back(object);
     }
 
 protected:
     Player *CreatePlayer(int index, PlayerStats *stats) override;
 
+    // The objects only ever cover the current screen
+    [[nodiscard]] int GetGridWidth() const override {
+        return WINDOW_WIDTH;
+    }
+
+    void DestroyPools() override;
+
     float SpawnLedders();
 
     void SpawnDarrs();
 
+    // Called by the timers of the screen, they schedule themselves again for the next spawn
+    void OnLeddersTimer();
+
+    void OnDarrsTimer();
+
     bool m_laserOn;
     short m_currentScreen = 0;
     short m_onTransition = -1;
@@ -131,11 +157,15 @@ protected:
     std::unordered_map<int, std::vector<PerspectiveLedderSpawn>> m_spawnPatterns;
     std::unordered_map<int, float> m_pretimes;
     std::unordered_map<int, DarrSpawn> m_darrs;
-    Music *m_bossMusic;
+    std::shared_ptr<Music> m_bossMusic;
     int m_currentSpawn;
-    float m_nextSpawn;
+    TimerHandle m_leddersTimer;
     int m_nextDarrsStart, m_nextDarrsEnd;
-    float m_nextDarrs;
+    TimerHandle m_darrsTimer;
+    // The enemies of the screens come and go all the time, so they are reused
+    PrefabPool<Darr> *m_darrPool;
+    PrefabPool<PerspectiveLedder> *m_ledderPool;
+    PrefabPool<PickUp> *m_pickupPool;
 
     /** Returns true if all players are on the floor instead of jumping */
     bool AllPlayersOnFloor();
@@ -11,131 +11,41 @@
 
 void
 ScrollingLevel::Create(const std::string &folder, const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets,
-                       YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *engine) {
-    Level::Create(folder, spritesheets, scene_root, num_players, stats, engine);
-    level_floor = std::make_shared<Floor>((folder + scene_root["floor_mask"].as<std::string>()).data());
-
-    for (const auto &rc_node: scene_root["rotating_canons"]) {
-        auto *tank = new RotatingCanon();
-        tank->Create(this,
-                rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM,
-                rc_node["burst_length"].as<int>());
-        tank->AddReceiver(this);
-        AddNotFoundEnemy(tank, RENDERING_LAYER_ENEMIES);
-    }
-    for (const auto &rc_node: scene_root["gulcans"]) {
-        auto *gulcan = new Gulcan();
-        gulcan->Create(this, rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM);
-        gulcan->AddReceiver(this);
-        AddNotFoundEnemy(gulcan, RENDERING_LAYER_ENEMIES);
-    }
-    for (const auto &rc_node: scene_root["ledders"]) {
-        auto *ledder = new Ledder();
-        ledder->Create(this,
-                rc_node["time_hidden"].as<float>(),
-                rc_node["time_shown"].as<float>(),
-                rc_node["cooldown_time"].as<float>(),
-                rc_node["show_standing"].as<bool>(),
-                rc_node["burst_length"].as<int>(),
-                rc_node["burst_cooldown"].as<float>(),
-                rc_node["horizontally_precise"].as<bool>()
-        );
-        ledder->position = rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM;
-        ledder->AddReceiver(this);
-        AddNotFoundEnemy(ledder, RENDERING_LAYER_ENEMIES);
-    }
-    for (const auto &rc_node: scene_root["greeders"]) {
-        if (rc_node["chance_skip"]) {
-            if (m_random_dist(m_mt) < rc_node["chance_skip"].as<float>())
-                continue;
-        }
-        auto *spawner = new GameObject();
-        spawner->position = rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM;
-        auto *greeder_spawner = new GreederSpawner();
-        greeder_spawner->Create(this, spawner, m_random_dist(m_mt));
-        spawner->AddComponent(greeder_spawner);
-        spawner->AddReceiver(this);
-        AddNotFoundEnemy(spawner, RENDERING_LAYER_ENEMIES);
-    }
-    for (const auto &rc_node: scene_root["covered_pickups"]) {
-        AnimationRenderer *renderer;
-        CreateAndAddPickUpHolder(rc_node["content"].as<PickUpType>(),
-                rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM,
-                new CoveredPickUpHolderBehaviour(),
-                {-12, -15, 10, 15},
-                &renderer);
-        renderer->AddAnimation({
-                1, 76, 0.15, 1,
-                34, 34, 17, 17,
-                "Closed", AnimationRenderer::STOP_AND_LAST
-        });
-        renderer->AddAnimation({
-                35, 110, 0.15, 3,
-                34, 34, 17, 17,
-                "Opening", AnimationRenderer::STOP_AND_LAST
-        });
-        renderer->AddAnimation({
-                137, 76, 0.15, 3,
-                34, 34, 17, 17,
-                "Open", AnimationRenderer::BOUNCE
-        });
-        renderer->AddAnimation({
-                92, 611, 0.15, 3,
-                30, 30, 15, 15,
-                "Dying", AnimationRenderer::BOUNCE_AND_STOP});
-    }
-    for (const auto &rc_node: scene_root["flying_pickups"]) {
-        AnimationRenderer *renderer;
-        CreateAndAddPickUpHolder(rc_node["content"].as<PickUpType>(),
-                rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM,
-                new FlyingPickupHolderBehaviour(),
-                {-9, -6, 9, 6},
-                &renderer);
-        renderer->AddAnimation({
-                243, 120, 0.15, 1,
-                24, 14, 12, 7,
-                "Flying", AnimationRenderer::STOP_AND_LAST
-        });
-        renderer->AddAnimation({
-                92, 611, 0.15, 3,
-                30, 30, 15, 15,
-                "Dying", AnimationRenderer::BOUNCE_AND_STOP});
-    }
-    for (const auto &rc_node: scene_root["exploding_bridges"]) {
-        auto *bridge = new GameObject();
-        bridge->Create();
-        auto *renderer = new AnimationRenderer();
-        renderer->Create(this, bridge, GetBridgeSprite());
-        for (int i = 0; i < 5; i++) {
-            std::string anim = "BridgeState" + std::to_string(i);
-            renderer->AddAnimation({0, i * 31, 0.15, 3,
-                                    128, 31, 0, 0,
-                                    anim, AnimationRenderer::BOUNCE});
-        }
-        auto *behaviour = new ExplodingBridgeBehaviour();
-        behaviour->Create(this, bridge);
-        bridge->AddComponent(renderer);
-        bridge->AddComponent(behaviour);
-        bridge->AddReceiver(this);
-        bridge->position = rc_node["pos"].as<Vector2D>() * PIXELS_ZOOM;
-
-        bridge->Init();
-        AddNotFoundEnemy(bridge, RENDERING_LAYER_BRIDGES);
-    }
+                       const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *engine) {
+    Level::Create(folder, spritesheets, data, num_players, stats, engine);
+    level_floor = std::make_shared<Floor>((folder + data.GetString(data.GetInfo().floorMask)).data());
+
+    // Only the parameters are kept, the objects are created as the camera reaches them
+    for (const auto &record: data.GetRecords<RotatingCanonRecord>(LEVEL_ROTATING_CANONS))
+        m_spawns.Add(SPAWN_ROTATING_CANON, record, &SpawnDescriptor::canon);
+    for (const auto &record: data.GetRecords<PositionRecord>(LEVEL_GULCANS))
+        m_spawns.Add(SPAWN_GULCAN, record, &SpawnDescriptor::position);
+    for (const auto &record: data.GetRecords<LedderRecord>(LEVEL_LEDDERS))
+        m_spawns.Add(SPAWN_LEDDER, record, &SpawnDescriptor::ledder);
+    for (const auto &record: data.GetRecords<GreederRecord>(LEVEL_GREEDERS))
+        m_spawns.Add(SPAWN_GREEDER, record, &SpawnDescriptor::greeder);
+    for (const auto &record: data.GetRecords<PickUpRecord>(LEVEL_COVERED_PICKUPS))
+        m_spawns.Add(SPAWN_COVERED_PICKUP, record, &SpawnDescriptor::pickup);
+    for (const auto &record: data.GetRecords<PickUpRecord>(LEVEL_FLYING_PICKUPS))
+        m_spawns.Add(SPAWN_FLYING_PICKUP, record, &SpawnDescriptor::pickup);
+    for (const auto &record: data.GetRecords<PositionRecord>(LEVEL_EXPLODING_BRIDGES))
+        m_spawns.Add(SPAWN_EXPLODING_BRIDGE, record, &SpawnDescriptor::position);
+    m_spawns.Sort();
 
+    // The pieces of the wall depend on each other, they are created up front
     CreateDefenseWall();
 }
 
 void ScrollingLevel::Init() {
     m_camera = Vector2D(0, 0);
-    if (!not_found_enemies.empty()) {
-        next_enemy_x = not_found_enemies.top().first->position.x;
-        while (next_enemy_x < WINDOW_WIDTH && !not_found_enemies.empty()) {
-            game_objects[not_found_enemies.top().second]->insert(not_found_enemies.top().first);
-            not_found_enemies.pop();
-            next_enemy_x = not_found_enemies.top().first->position.x;
-        }
+    m_spawns.Rewind();
+    SpawnUntil(WINDOW_WIDTH, false);
+    while (!not_found_enemies.empty() && not_found_enemies.top().first->position.x < WINDOW_WIDTH) {
+        game_objects[not_found_enemies.top().second].Insert(not_found_enemies.top().first);
+        not_found_enemies.pop();
     }
+    if (!not_found_enemies.empty())
+        next_enemy_x = not_found_enemies.top().first->position.x;
 
     Level::Init();
 }
@@ -163,28 +73,31 @@ void ScrollingLevel::SubUpdate(float dt) {
             m_camera.x = levelWidth - WINDOW_WIDTH;
     }
 
+    // Keep the floor around the camera and the next chunk ready
+    level_floor->Stream(int(m_camera.x - RENDERING_MARGINS) / PIXELS_ZOOM,
+            int(m_camera.x + WINDOW_WIDTH + RENDERING_MARGINS) / PIXELS_ZOOM + Floor::CHUNK_WIDTH);
+
     // Progressively init the enemies in front of the camera
-    while (m_camera.x + WINDOW_WIDTH + RENDERING_MARGINS > next_enemy_x && !not_found_enemies.empty()) {
+    SpawnUntil(m_camera.x + WINDOW_WIDTH + RENDERING_MARGINS, true);
+    while (!not_found_enemies.empty() && m_camera.x + WINDOW_WIDTH + RENDERING_MARGINS > next_enemy_x) {
         auto *enemy = not_found_enemies.top().first;
-        game_objects[not_found_enemies.top().second]->insert(enemy);
+        game_objects[not_found_enemies.top().second].Insert(enemy);
         enemy->Init();
         not_found_enemies.pop();
-        next_enemy_x = not_found_enemies.top().first->position.x;
+        if (!not_found_enemies.empty())
+            next_enemy_x = not_found_enemies.top().first->position.x;
     }
 
     // Eliminate the enemies behind the camera
-    std::set<GameObject *>::iterator it = game_objects[RENDERING_LAYER_ENEMIES]->begin();
-    while (it != game_objects[RENDERING_LAYER_ENEMIES]->end()) {
-        auto *game_object = *it;
+    for (auto *game_object : game_objects[RENDERING_LAYER_ENEMIES]) {
         if (game_object->position.x < m_camera.x - RENDERING_MARGINS) {
-            it = game_objects[RENDERING_LAYER_ENEMIES]->erase(it);
+            game_objects[RENDERING_LAYER_ENEMIES].Erase(game_object);
             if (game_object->onRemoval == DESTROY) {
                 game_object->Destroy();
             }
-        } else {
-            it++;
         }
     }
+    RecycleRemoved();
 }
 
 void ScrollingLevel::Destroy() {
@@ -192,12 +105,192 @@ void ScrollingLevel::Destroy() {
         not_found_enemies.top().first->Destroy();
         not_found_enemies.pop();
     }
+    // Not destroyed by the level, they do not destroy on removal
+    for (auto &spawned : m_spawned)
+        spawned.game_object->Destroy();
+    m_spawned.clear();
+    for (auto &dormant : m_dormant) {
+        for (auto *game_object : dormant)
+            game_object->Destroy();
+        dormant.clear();
+    }
+    m_spawns.Clear();
     Level::Destroy();
 }
 
-void ScrollingLevel::CreateAndAddPickUpHolder(const PickUpType &type, const Vector2D &position,
-                                              PickUpHolderBehaviour *behaviour, const Box &box,
-                                              AnimationRenderer **renderer) {
+void ScrollingLevel::SpawnUntil(float right_x, bool init) {
+    while (const SpawnDescriptor *spawn = m_spawns.Next(right_x)) {
+        short layer = RENDERING_LAYER_ENEMIES;
+        GameObject *game_object = Spawn(*spawn, layer);
+        if (!game_object)
+            continue;
+        game_objects[layer].Insert(game_object);
+        if (init)
+            game_object->Init();
+    }
+}
+
+GameObject *ScrollingLevel::Spawn(const SpawnDescriptor &spawn, short &layer) {
+    if (spawn.type == SPAWN_GREEDER && spawn.greeder.chanceSkip > 0.f) {
+        if (m_random_dist(m_mt) < spawn.greeder.chanceSkip)
+            return nullptr;
+    }
+
+    GameObject *game_object = nullptr;
+    auto &dormant = m_dormant[spawn.type];
+    if (!dormant.empty()) {
+        game_object = dormant.back();
+        dormant.pop_back();
+        // Back to how it was created, as the pools do, before configuring it again
+        game_object->Reset();
+    }
+
+    switch (spawn.type) {
+        case SPAWN_ROTATING_CANON: {
+            const auto &record = spawn.canon;
+            if (game_object) {
+                game_object->position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
+                game_object->GetComponent<CanonBehaviour *>()->SetBurstLength(record.burstLength);
+            } else {
+                auto *tank = new RotatingCanon();
+                tank->Create(this,
+                        Vector2D(record.x, record.y) * PIXELS_ZOOM,
+                        record.burstLength);
+                tank->AddReceiver(this);
+                game_object = tank;
+            }
+            break;
+        }
+        case SPAWN_GULCAN: {
+            const auto &record = spawn.position;
+            if (game_object) {
+                game_object->position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
+            } else {
+                auto *gulcan = new Gulcan();
+                gulcan->Create(this, Vector2D(record.x, record.y) * PIXELS_ZOOM);
+                gulcan->AddReceiver(this);
+                game_object = gulcan;
+            }
+            break;
+        }
+        case SPAWN_LEDDER: {
+            const auto &record = spawn.ledder;
+            auto *ledder = static_cast<Ledder *>(game_object);
+            if (ledder) {
+                ledder->Configure(
+                        record.timeHidden,
+                        record.timeShown,
+                        record.cooldownTime,
+                        record.showStanding,
+                        record.burstLength,
+                        record.burstCooldown,
+                        record.horizontallyPrecise
+                );
+            } else {
+                ledder = new Ledder();
+                ledder->Create(this,
+                        record.timeHidden,
+                        record.timeShown,
+                        record.cooldownTime,
+                        record.showStanding,
+                        record.burstLength,
+                        record.burstCooldown,
+                        record.horizontallyPrecise
+                );
+                ledder->AddReceiver(this);
+            }
+            ledder->position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
+            game_object = ledder;
+            break;
+        }
+        case SPAWN_GREEDER: {
+            const auto &record = spawn.greeder;
+            if (game_object) {
+                game_object->GetComponent<GreederSpawner *>()->SetRandomInterval(m_random_dist(m_mt));
+            } else {
+                game_object = new GameObject();
+                auto *greeder_spawner = new GreederSpawner();
+                greeder_spawner->Create(this, game_object, m_random_dist(m_mt));
+                game_object->AddComponent(greeder_spawner);
+                game_object->AddReceiver(this);
+            }
+            game_object->position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
+            break;
+        }
+        case SPAWN_COVERED_PICKUP: {
+            const auto &record = spawn.pickup;
+            AnimationRenderer *renderer;
+            game_object = CreatePickUpHolder(PickUpType(record.content),
+                    Vector2D(record.x, record.y) * PIXELS_ZOOM,
+                    new CoveredPickUpHolderBehaviour(),
+                    {-12, -15, 10, 15},
+                    &renderer);
+            renderer->SetAnimationSet(GetAnimationSet(AnimationId("covered_pickup_holder")));
+            break;
+        }
+        case SPAWN_FLYING_PICKUP: {
+            const auto &record = spawn.pickup;
+            AnimationRenderer *renderer;
+            game_object = CreatePickUpHolder(PickUpType(record.content),
+                    Vector2D(record.x, record.y) * PIXELS_ZOOM,
+                    new FlyingPickupHolderBehaviour(),
+                    {-9, -6, 9, 6},
+                    &renderer);
+            renderer->SetAnimationSet(GetAnimationSet(AnimationId("flying_pickup_holder")));
+            break;
+        }
+        case SPAWN_EXPLODING_BRIDGE: {
+            const auto &record = spawn.position;
+            auto *bridge = new GameObject();
+            bridge->Create();
+            auto *renderer = new AnimationRenderer();
+            renderer->Create(this, bridge, GetBridgeSprite());
+            renderer->SetAnimationSet(GetAnimationSet(AnimationId("exploding_bridge")));
+            auto *behaviour = new ExplodingBridgeBehaviour();
+            behaviour->Create(this, bridge);
+            bridge->AddComponent(renderer);
+            bridge->AddComponent(behaviour);
+            bridge->AddReceiver(this);
+            bridge->position = Vector2D(record.x, record.y) * PIXELS_ZOOM;
+
+            bridge->Init();
+            layer = RENDERING_LAYER_BRIDGES;
+            game_object = bridge;
+            break;
+        }
+        default:
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "ScrollingLevel::Spawn: Unknown spawn type %d", spawn.type);
+            return nullptr;
+    }
+
+    // Spawned ahead of the camera, they do not need a full update until they get close to the screen. Not the
+    // bridges, anchored at their left side they are still on screen long after it has gone past their position.
+    game_object->sleepsOffScreen = spawn.type != SPAWN_EXPLODING_BRIDGE;
+    // The enemies are reused, the holders and bridges can not be restored once they have been destroyed
+    if (spawn.type <= SPAWN_GREEDER) {
+        game_object->onRemoval = DO_NOT_DESTROY;
+        m_spawned.push_back({game_object, spawn.type});
+    }
+    return game_object;
+}
+
+void ScrollingLevel::RecycleRemoved() {
+    for (size_t i = 0; i < m_spawned.size();) {
+        if (game_objects[RENDERING_LAYER_ENEMIES].Contains(m_spawned[i].game_object)) {
+            i++;
+            continue;
+        }
+        // Out of the collision grid, its cells are reused for other places as the camera moves on
+        m_spawned[i].game_object->OnAsleep();
+        m_dormant[m_spawned[i].type].push_back(m_spawned[i].game_object);
+        m_spawned[i] = m_spawned.back();
+        m_spawned.pop_back();
+    }
+}
+
+GameObject *ScrollingLevel::CreatePickUpHolder(const PickUpType &type, const Vector2D &position,
+                                               PickUpHolderBehaviour *behaviour, const Box &box,
+                                               AnimationRenderer **renderer) {
     auto *pickup = new PickUp();
     pickup->Create(this, GetSpritesheet(SPRITESHEET_PICKUPS), &m_grid, level_floor, type);
     auto *pick_up_holder = new GameObject();
@@ -213,7 +306,7 @@ void ScrollingLevel::CreateAndAddPickUpHolder(const PickUpType &type, const Vect
     pick_up_holder->AddComponent(*renderer);
     pick_up_holder->AddComponent(collider);
     pick_up_holder->AddReceiver(this);
-    AddNotFoundEnemy(pick_up_holder, RENDERING_LAYER_ENEMIES);
+    return pick_up_holder;
 }
 
 void ScrollingLevel::CreateDefenseWall() {
@@ -253,11 +346,7 @@ void ScrollingLevel::CreateDefenseWall() {
     door->AddComponent(renderer); // Important order! First the back, then the animated
     auto *animator = new AnimationRenderer();
     animator->Create(this, door, sprite);
-    animator->AddAnimation({
-            1, 82, 0.15, 3,
-            24, 32, -6, -16,
-            "Door", AnimationRenderer::BOUNCE
-    });
+    animator->SetAnimationSet(GetAnimationSet(AnimationId("defense_door")));
     animator->Play();
     auto *door_behaviour = new DefenseDoorBehaviour();
     door_behaviour->Create(this, door);
@@ -279,11 +368,7 @@ void ScrollingLevel::CreateDefenseWall() {
     canon->Create();
     animator = new AnimationRenderer();
     animator->Create(this, canon, sprite);
-    animator->AddAnimation({
-            1, 66, 0.2, 2,
-            25, 15, 0, 0,
-            "Shoot", AnimationRenderer::STOP_AND_FIRST
-    });
+    animator->SetAnimationSet(GetAnimationSet(AnimationId("blaster_canon")));
     animator->Pause();
     auto *behaviour = new BlasterCanonBehaviour();
     behaviour->Create(this, canon, pool);
@@ -303,11 +388,7 @@ void ScrollingLevel::CreateDefenseWall() {
     canon->Create();
     animator = new AnimationRenderer();
     animator->Create(this, canon, sprite);
-    animator->AddAnimation({
-            1, 66, 0.2, 2,
-            25, 15, 0, 0,
-            "Shoot", AnimationRenderer::STOP_AND_FIRST
-    });
+    animator->SetAnimationSet(GetAnimationSet(AnimationId("blaster_canon")));
     animator->Pause();
     behaviour = new BlasterCanonBehaviour();
     behaviour->Create(this, canon, pool);
@@ -326,19 +407,12 @@ void ScrollingLevel::CreateDefenseWall() {
 ObjectPool<Bullet> *ScrollingLevel::CreateBlasterBulletPool() {
     auto *pool = new ObjectPool<Bullet>();
     pool->Create(MAX_BLASTER_CANON_BULLETS);
+    auto animations = GetAnimationSet(AnimationId("blaster_bullet"));
     for (auto *bullet: pool->pool) {
         bullet->Create();
         auto *renderer = new AnimationRenderer();
         renderer->Create(this, bullet, GetSpritesheet(SPRITESHEET_ENEMIES));
-        renderer->AddAnimation({
-                204, 67, 0.2, 1,
-                8, 8, 4, 4,
-                "Bullet", AnimationRenderer::STOP_AND_FIRST
-        });
-        renderer->AddAnimation({
-                92, 611, 0.15, 3,
-                30, 30, 15, 15,
-                "Kill", AnimationRenderer::BOUNCE_AND_STOP});
+        renderer->SetAnimationSet(animations);
         renderer->Play();
         auto *gravity = new Gravity();
         gravity->Create(this, bullet);
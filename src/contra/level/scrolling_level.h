@@ -5,8 +5,8 @@
 #ifndef CONTRA_SCROLLING_LEVEL_H
 #define CONTRA_SCROLLING_LEVEL_H
 
-#include <yaml-cpp/yaml.h>
 #include "level.h"
+#include "spawn_table.h"
 
 class ScrollingLevel : public Level {
 private:
@@ -18,9 +18,21 @@ private:
 
     std::priority_queue<std::pair<GameObject *, short>, std::deque<std::pair<GameObject *, short>>, game_objects_comp_x> not_found_enemies;
     float next_enemy_x;
+
+    struct SpawnedEnemy {
+        GameObject *game_object;
+        SpawnType type;
+    };
+
+    // The enemies, pickup holders and bridges of the level, only created once the camera gets close to them
+    SpawnTable m_spawns;
+    // Spawned objects that go back to m_dormant when they leave the level
+    std::vector<SpawnedEnemy> m_spawned;
+    // Objects that left the level, per type, to be configured and spawned again instead of creating new ones
+    std::vector<GameObject *> m_dormant[SPAWN_TYPE_COUNT];
 public:
     void Create(const std::string &folder, const std::unordered_map<int, std::shared_ptr<Sprite>> *spritesheets,
-                YAML::Node scene_root, short num_players, PlayerStats *stats, AvancezLib *engine) override;
+                const LevelData &data, short num_players, PlayerStats *stats, AvancezLib *engine) override;
 
     void Init() override;
 
@@ -37,11 +49,29 @@ public:
     }
 
 private:
+    /**
+     * Spawns everything in the spawn table before right_x
+     * @param init Whether to init the spawned objects, false if the level will init them
+     */
+    void SpawnUntil(float right_x, bool init);
+
+    /**
+     * Creates the object of a spawn, or reuses one that left the level
+     * @param layer Set to the rendering layer of the object
+     * @return The object, nullptr if the spawn is skipped
+     */
+    GameObject *Spawn(const SpawnDescriptor &spawn, short &layer);
+
+    /**
+     * Takes back the spawned objects that are not in the level any more, either killed or behind the camera
+     */
+    void RecycleRemoved();
+
     /**
      * @param behaviour Create will be called, no need to create it first
      */
-    void CreateAndAddPickUpHolder(const PickUpType &type, const Vector2D &position, PickUpHolderBehaviour *behaviour,
-                                  const Box &box, AnimationRenderer **renderer_out);
+    GameObject *CreatePickUpHolder(const PickUpType &type, const Vector2D &position, PickUpHolderBehaviour *behaviour,
+                                   const Box &box, AnimationRenderer **renderer_out);
 
     /**
      * Creates the defense wall of the end of stage 1
@@ -52,6 +82,11 @@ private:
 
 protected:
     Player *CreatePlayer(int index, PlayerStats *stats) override;
+
+    // The grid follows the camera, wide enough for everything updated around it
+    [[nodiscard]] int GetGridWidth() const override {
+        return WINDOW_WIDTH + 4 * RENDERING_MARGINS;
+    }
 };
 
 #endif //CONTRA_SCROLLING_LEVEL_H
@@ -0,0 +1,94 @@
+#ifndef CONTRA_SPAWN_TABLE_H
+#define CONTRA_SPAWN_TABLE_H
+
+#include <algorithm>
+#include <vector>
+#include "../../consts.h"
+#include "level_data.h"
+
+enum SpawnType {
+    SPAWN_ROTATING_CANON,
+    SPAWN_GULCAN,
+    SPAWN_LEDDER,
+    SPAWN_GREEDER,
+    SPAWN_COVERED_PICKUP,
+    SPAWN_FLYING_PICKUP,
+    SPAWN_EXPLODING_BRIDGE,
+    SPAWN_TYPE_COUNT
+};
+
+/**
+ * What has to be spawned at a point of the level, only the type and its parameters, copied from the
+ * records of the level so the level data does not need to outlive the creation of the level
+ */
+struct SpawnDescriptor {
+    float x; // Zoomed level pixels, the key of the table
+    SpawnType type;
+    union {
+        PositionRecord position; // Gulcans and exploding bridges
+        RotatingCanonRecord canon;
+        LedderRecord ledder;
+        GreederRecord greeder;
+        PickUpRecord pickup;
+    };
+};
+
+/**
+ * The spawns of a level sorted by x, with a cursor that only moves forward as the camera does.
+ * The table itself holds no game objects, these are created when the cursor reaches them.
+ */
+class SpawnTable {
+public:
+    /**
+     * Adds a spawn, the positions of the record are in level pixels
+     */
+    template<class T>
+    void Add(SpawnType type, const T &record, T SpawnDescriptor::*params) {
+        SpawnDescriptor descriptor{};
+        descriptor.x = record.x * PIXELS_ZOOM;
+        descriptor.type = type;
+        descriptor.*params = record;
+        m_spawns.push_back(descriptor);
+    }
+
+    /**
+     * Sorts the spawns once all of them have been added, spawns at the same x keep the order they were added
+     */
+    void Sort() {
+        std::stable_sort(m_spawns.begin(), m_spawns.end(), [](const SpawnDescriptor &lhs, const SpawnDescriptor &rhs) {
+            return lhs.x < rhs.x;
+        });
+        m_spawns.shrink_to_fit();
+        m_cursor = 0;
+    }
+
+    void Rewind() {
+        m_cursor = 0;
+    }
+
+    /**
+     * Advances the cursor past the next spawn if it is before right_x
+     * @return The spawn, nullptr if there is none left before right_x
+     */
+    const SpawnDescriptor *Next(float right_x) {
+        if (m_cursor >= m_spawns.size() || m_spawns[m_cursor].x >= right_x)
+            return nullptr;
+        return &m_spawns[m_cursor++];
+    }
+
+    [[nodiscard]] size_t Size() const {
+        return m_spawns.size();
+    }
+
+    void Clear() {
+        m_spawns.clear();
+        m_spawns.shrink_to_fit();
+        m_cursor = 0;
+    }
+
+private:
+    std::vector<SpawnDescriptor> m_spawns;
+    size_t m_cursor = 0;
+};
+
+#endif //CONTRA_SPAWN_TABLE_H
@@ -8,6 +8,7 @@
 #include <yaml-cpp/yaml.h>
 #include "../../kernel/vector2D.h"
 #include "../entities/pickup_types.h"
+#include "../../components/render/AnimationRenderer.h"
 
 namespace YAML {
     template<>
@@ -50,6 +51,45 @@ namespace YAML {
             return true;
         }
     };
+    template<>
+    struct convert<AnimationRenderer::AnimationStop> {
+        static bool decode(const Node &node, AnimationRenderer::AnimationStop &stop) {
+            const auto name = node.as<std::string>();
+            if (name == "DONT_STOP") {
+                stop = AnimationRenderer::DONT_STOP;
+            } else if (name == "BOUNCE") {
+                stop = AnimationRenderer::BOUNCE;
+            } else if (name == "BOUNCE_AND_STOP") {
+                stop = AnimationRenderer::BOUNCE_AND_STOP;
+            } else if (name == "STOP_AND_FIRST") {
+                stop = AnimationRenderer::STOP_AND_FIRST;
+            } else if (name == "STOP_AND_LAST") {
+                stop = AnimationRenderer::STOP_AND_LAST;
+            } else {
+                return false;
+            }
+            return true;
+        }
+    };
+    template<>
+    struct convert<AnimationRenderer::Animation> {
+        static bool decode(const Node &node, AnimationRenderer::Animation &animation) {
+            if (!node.IsMap() || !node["start"] || !node["size"] || !node["anchor"]) {
+                return false;
+            }
+            animation.start_x = node["start"][0].as<int>();
+            animation.start_y = node["start"][1].as<int>();
+            animation.speed = node["speed"].as<float>();
+            animation.frames = node["frames"].as<short>();
+            animation.frame_w = node["size"][0].as<int>();
+            animation.frame_h = node["size"][1].as<int>();
+            animation.anchor_x = node["anchor"][0].as<int>();
+            animation.anchor_y = node["anchor"][1].as<int>();
+            animation.name = node["name"].as<std::string>();
+            animation.stop = node["stop"].as<AnimationRenderer::AnimationStop>();
+            return true;
+        }
+    };
 }
 
 #endif //CONTRA_YAML_CONVERTERS_H
@@ -85,16 +85,38 @@ void PreLevel::Update(float dt) {
     MenuWithStats::Update(dt);
     AvancezLib::KeyStatus keyStatus;
     m_engine->getKeyStatus(keyStatus);
+    if (m_loading.valid() && m_loading.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        m_level = m_loading.get();
+        if (!m_level) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Stage %d could not be loaded", m_stage);
+            m_game->Receive(GO_TO_MAIN_MENU);
+            return;
+        }
+        m_level->AddReceiver(m_game);
+    }
+
     char msg[100];
-    sprintf(reinterpret_cast<char *>(&msg), "STAGE %d: %s",
-            m_level->GetLevelIndex(), &m_level->GetLevelName()[0]);
+    if (m_level) {
+        sprintf(reinterpret_cast<char *>(&msg), "STAGE %d: %s",
+                m_level->GetLevelIndex(), &m_level->GetLevelName()[0]);
+    } else {
+        sprintf(reinterpret_cast<char *>(&msg), "STAGE %d", m_stage);
+    }
     m_engine->drawText(WINDOW_WIDTH / 2, WINDOW_WIDTH / 2,
             msg, {188, 188, 188}, AvancezLib::TEXT_ALIGN_CENTER_MIDDLE);
     m_time += dt;
 
-    if ((keyStatus.start && m_time > 0.5f) || m_time > 5.f) {
-        m_level->Init();
-        m_game->Start(m_level);
+    // Waiting for the uploads too, so the first frames of the level do not create the textures
+    if (m_level && m_engine->getPendingUploads() == 0 &&
+        ((keyStatus.start && m_time > SDL_min(0.5f, m_duration)) || m_time >= m_duration)) {
+        Level *level = m_level;
+        m_level = nullptr; // Owned by the game from now on
+        {
+            // What the level spawns on Init belongs to it
+            Arena::Scope scope(level->GetArena());
+            level->Init();
+        }
+        m_game->Start(level);
     }
 }
 
@@ -7,6 +7,7 @@
 
 #include "../components/scene.h"
 #include "../components/render/SimpleRenderer.h"
+#include <future>
 #include "game.h"
 
 class MainMenu : public BaseScene {
@@ -26,10 +27,10 @@ public:
         selector->Create();
         auto *render = new SimpleRenderer();
         render->Create(this, selector,
-                std::shared_ptr<Sprite>(m_engine->createSprite("data/main_menu/menu_spritesheet.png")),
+                m_engine->getAssets().GetSprite("data/main_menu/menu_spritesheet.png"),
                 0, 0, 16, 10, 0, 0);
         selector->AddComponent(render);
-        game_objects[0]->insert(selector);
+        game_objects[0].Insert(selector);
 
         options[0] = Vector2D(35, 151) * PIXELS_ZOOM;
         options[1] = Vector2D(35, 167) * PIXELS_ZOOM;
@@ -63,18 +64,45 @@ public:
     void Update(float dt) override;
 };
 
+/**
+ * Stage introduction, shown while the level is loaded in the background. The level starts once it
+ * is loaded, its textures are uploaded and the introduction has been shown long enough.
+ */
 class PreLevel: public MenuWithStats {
 private:
     float m_time;
-    Level* m_level;
+    float m_duration;
+    int m_stage;
+    std::future<Level *> m_loading;
+    Level* m_level = nullptr;
 public:
-    void Init(Level* level) {
+    /**
+     * @param loading The level being loaded, owned by the introduction until it is started
+     * @param stage Number of the stage to show until the level is loaded
+     * @param duration Time the introduction is shown, it can be skipped with start after half a second
+     */
+    void Init(std::future<Level *> loading, int stage, float duration = 5.f) {
         MenuWithStats::Init();
-        m_level = level;
+        m_loading = std::move(loading);
+        m_level = nullptr;
+        m_stage = stage;
+        m_duration = duration;
         m_time = 0;
     }
 
     void Update(float dt) override;
+
+    void Destroy() override {
+        // Left before the level started, i.e. quitting the game
+        if (m_loading.valid())
+            m_level = m_loading.get();
+        if (m_level) {
+            m_level->Destroy();
+            delete m_level;
+            m_level = nullptr;
+        }
+        MenuWithStats::Destroy();
+    }
 };
 
 class ContinueLevel: public MenuWithStats {
@@ -90,11 +118,11 @@ public:
         selector->Create();
         auto *render = new SimpleRenderer();
         render->Create(this, selector,
-                std::shared_ptr<Sprite>(m_engine->createSprite("data/main_menu/menu_spritesheet.png")),
+                m_engine->getAssets().GetSprite("data/main_menu/menu_spritesheet.png"),
                 0, 0, 16, 10, 8, 5);
         selector->AddComponent(render);
         selector->Init();
-        game_objects[0]->insert(selector);
+        game_objects[0].Insert(selector);
 
         options[0] = Vector2D(35, 151) * PIXELS_ZOOM;
         options[1] = Vector2D(35, 167) * PIXELS_ZOOM;
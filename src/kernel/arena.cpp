@@ -0,0 +1,84 @@
+#include "arena.h"
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+thread_local Arena *Arena::s_current = nullptr;
+
+struct Arena::Header {
+    Arena *arena; // nullptr if allocated on the heap
+    Header *next; // Next allocation of the same sub-arena
+    Destructor destructor; // nullptr once destroyed
+};
+
+const size_t Arena::HEADER_SIZE = (sizeof(Header) + alignof(std::max_align_t) - 1)
+                                  & ~(alignof(std::max_align_t) - 1);
+
+void *Arena::Allocate(size_t size, Kind kind, Destructor destructor) {
+    if (s_current)
+        return s_current->Bump(size, kind, destructor);
+    auto *header = static_cast<Header *>(::operator new(HEADER_SIZE + size));
+    header->arena = nullptr;
+    header->next = nullptr;
+    header->destructor = destructor;
+    return memset(reinterpret_cast<char *>(header) + HEADER_SIZE, 0, size);
+}
+
+void Arena::Free(void *memory) {
+    if (memory == nullptr)
+        return;
+    auto *header = reinterpret_cast<Header *>(static_cast<char *>(memory) - HEADER_SIZE);
+    if (header->arena == nullptr)
+        ::operator delete(header);
+    else
+        header->destructor = nullptr;
+}
+
+void *Arena::Bump(size_t size, Kind kind, Destructor destructor) {
+    SubArena &sub_arena = m_subArenas[kind];
+    size_t needed = (HEADER_SIZE + size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    if (sub_arena.blocks.empty() || sub_arena.offset + needed > sub_arena.capacity) {
+        // Bigger ones than a block get a block of their own
+        sub_arena.capacity = needed > m_blockSize ? needed : m_blockSize;
+        sub_arena.blocks.push_back(static_cast<char *>(::operator new(sub_arena.capacity)));
+        sub_arena.offset = 0;
+    }
+    auto *header = reinterpret_cast<Header *>(sub_arena.blocks.back() + sub_arena.offset);
+    sub_arena.offset += needed;
+    sub_arena.used += needed;
+
+    header->arena = this;
+    header->next = nullptr;
+    header->destructor = destructor;
+    if (sub_arena.last)
+        sub_arena.last->next = header;
+    else
+        sub_arena.first = header;
+    sub_arena.last = header;
+    // Zeroed as the blocks are reused after a release, and components find their pointers on Init if null
+    return memset(reinterpret_cast<char *>(header) + HEADER_SIZE, 0, size);
+}
+
+void Arena::Release() {
+    for (auto &sub_arena : m_subArenas) {
+        for (Header *header = sub_arena.first; header; header = header->next) {
+            if (header->destructor) {
+                Destructor destructor = header->destructor;
+                header->destructor = nullptr;
+                destructor(reinterpret_cast<char *>(header) + HEADER_SIZE);
+            }
+        }
+    }
+    for (auto &sub_arena : m_subArenas) {
+        for (char *block : sub_arena.blocks)
+            ::operator delete(block);
+        sub_arena = SubArena();
+    }
+}
+
+size_t Arena::GetUsed() const {
+    size_t used = 0;
+    for (const auto &sub_arena : m_subArenas)
+        used += sub_arena.used;
+    return used;
+}
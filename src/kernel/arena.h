@@ -0,0 +1,100 @@
+#ifndef CONTRA_ARENA_H
+#define CONTRA_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Bump allocator for the game objects and components of a level, which are created all over the entities
+ * and never freed one by one. Everything allocated in the arena is freed at once on Release.
+ *
+ * GameObject and Component allocate from the current arena of the thread, set with Arena::Scope, or from
+ * the heap when there is none, so `new` keeps working the same everywhere. Each of them has its own
+ * sub-arena, so the objects of a level are packed together and so are their components.
+ *
+ * Deleting something of the arena only runs its destructor. Release runs the destructors of the ones
+ * still alive, the game objects first (they delete their components) and each sub-arena in allocation
+ * order, so an owner, always created before what it owns, is the one deleting it.
+ */
+class Arena {
+public:
+    enum Kind {
+        GAME_OBJECTS,
+        COMPONENTS,
+        KIND_COUNT
+    };
+
+    // Destroys the object built at the start of the memory, the class must be its first base
+    typedef void (*Destructor)(void *object);
+
+    /**
+     * Makes the arena the current one of the thread while in scope, nullptr allocates from the heap
+     */
+    class Scope {
+    public:
+        explicit Scope(Arena *arena) : m_previous(s_current) {
+            s_current = arena;
+        }
+
+        ~Scope() {
+            s_current = m_previous;
+        }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        Arena *m_previous;
+    };
+
+    explicit Arena(size_t block_size = 64 * 1024) : m_blockSize(block_size) {}
+
+    ~Arena() {
+        Release();
+    }
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * Allocates zeroed memory from the current arena of the thread, or from the heap if there is none
+     * @param destructor Called on Release if the object is still alive
+     */
+    static void *Allocate(size_t size, Kind kind, Destructor destructor);
+
+    /**
+     * Frees memory returned by Allocate once its object has been destroyed. The memory of an arena is
+     * only reclaimed on Release.
+     */
+    static void Free(void *memory);
+
+    /** Destroys what is still alive and frees all the memory, the arena can be used again afterwards */
+    void Release();
+
+    // Bytes handed out since the last release, headers included
+    [[nodiscard]] size_t GetUsed() const;
+
+private:
+    struct Header;
+
+    // Keeps the objects after the headers aligned as the ones from the heap
+    static const size_t HEADER_SIZE;
+
+    struct SubArena {
+        std::vector<char *> blocks;
+        size_t offset = 0, capacity = 0; // Of the last block
+        size_t used = 0;
+        Header *first = nullptr, *last = nullptr;
+    };
+
+    void *Bump(size_t size, Kind kind, Destructor destructor);
+
+    static thread_local Arena *s_current;
+
+    size_t m_blockSize;
+    SubArena m_subArenas[KIND_COUNT];
+};
+
+#endif //CONTRA_ARENA_H
@@ -0,0 +1,135 @@
+#include "asset_cache.h"
+#include "avancezlib.h"
+
+void AssetCache::Create(AvancezLib *avancez_lib, size_t budget_bytes) {
+    engine = avancez_lib;
+    budget = budget_bytes;
+    mainThread = std::this_thread::get_id();
+}
+
+void AssetCache::Destroy() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sprites.clear();
+    sounds.clear();
+    music.clear();
+    used = 0;
+}
+
+template<class T>
+std::shared_ptr<T> AssetCache::Touch(Entries<T> &entries, const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(path);
+    if (it == entries.end())
+        return nullptr;
+    it->second.lastUse = ++clock;
+    return it->second.asset;
+}
+
+template<class T>
+std::shared_ptr<T> AssetCache::Insert(Entries<T> &entries, const std::string &path, std::shared_ptr<T> asset,
+                                      size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        // Loaded twice at the same time, the copy of this thread is freed when released
+        it->second.lastUse = ++clock;
+        return it->second.asset;
+    }
+    entries[path] = {asset, bytes, ++clock};
+    used += bytes;
+    TrimLocked();
+    return asset;
+}
+
+template<class T>
+bool AssetCache::FindEvictable(Entries<T> &entries, typename Entries<T>::iterator &oldest) {
+    bool found = false;
+    for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (it->second.asset.use_count() == 1 && (!found || it->second.lastUse < oldest->second.lastUse)) {
+            oldest = it;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void AssetCache::Trim() {
+    std::lock_guard<std::mutex> lock(mutex);
+    TrimLocked();
+}
+
+void AssetCache::TrimLocked() {
+    if (std::this_thread::get_id() != mainThread)
+        return; // Trimmed on the next insertion from the main thread
+    while (used > budget) {
+        Entries<Sprite>::iterator sprite;
+        Entries<SoundEffect>::iterator sound;
+        Entries<Music>::iterator track;
+        bool has_sprite = FindEvictable(sprites, sprite);
+        bool has_sound = FindEvictable(sounds, sound);
+        bool has_track = FindEvictable(music, track);
+        if (!has_sprite && !has_sound && !has_track)
+            return; // Everything left is in use
+
+        Uint64 sprite_use = has_sprite ? sprite->second.lastUse : UINT64_MAX;
+        Uint64 sound_use = has_sound ? sound->second.lastUse : UINT64_MAX;
+        Uint64 track_use = has_track ? track->second.lastUse : UINT64_MAX;
+        if (sprite_use <= sound_use && sprite_use <= track_use) {
+            used -= sprite->second.bytes;
+            sprites.erase(sprite);
+        } else if (sound_use <= track_use) {
+            used -= sound->second.bytes;
+            sounds.erase(sound);
+        } else {
+            used -= track->second.bytes;
+            music.erase(track);
+        }
+    }
+}
+
+std::shared_ptr<Sprite> AssetCache::GetSprite(const std::string &path) {
+    if (auto sprite = Touch(sprites, path))
+        return sprite;
+    std::shared_ptr<Sprite> sprite(engine->createSprite(path.c_str()));
+    if (!sprite) {
+        // Not cached, nor counted, so it is tried again next time
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "AssetCache::GetSprite: Could not load %s", path.c_str());
+        return nullptr;
+    }
+    return Insert(sprites, path, sprite, size_t(sprite->getWidth()) * sprite->getHeight() * 4);
+}
+
+std::shared_ptr<SoundEffect> AssetCache::GetSound(const std::string &path, int max_instances, int priority) {
+    if (auto sound = Touch(sounds, path))
+        return sound;
+    std::shared_ptr<SoundEffect> sound(engine->createSound(path.c_str(), max_instances, priority));
+    return Insert(sounds, path, sound, sound->GetBytes());
+}
+
+std::shared_ptr<Music> AssetCache::GetMusic(const std::string &path) {
+    if (auto track = Touch(music, path))
+        return track;
+    std::shared_ptr<Music> track(engine->createMusic(path.c_str()));
+    // The music is streamed, the file size is a good enough estimate
+    size_t bytes = 0;
+    if (SDL_RWops *file = SDL_RWFromFile(path.c_str(), "rb")) {
+        bytes = size_t(SDL_max(Sint64(0), SDL_RWsize(file)));
+        SDL_RWclose(file);
+    }
+    return Insert(music, path, track, bytes);
+}
+
+void AssetCache::PreloadSprites(std::initializer_list<const char *> paths) {
+    for (const char *path : paths)
+        GetSprite(path);
+}
+
+void AssetCache::PreloadSounds(std::initializer_list<const char *> paths, int max_instances, int priority) {
+    for (const char *path : paths)
+        GetSound(path, max_instances, priority);
+}
+
+void AssetCache::PreloadMusic(std::initializer_list<const char *> paths) {
+    for (const char *path : paths)
+        GetMusic(path);
+}
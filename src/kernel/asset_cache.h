@@ -0,0 +1,102 @@
+#ifndef CONTRA_ASSET_CACHE_H
+#define CONTRA_ASSET_CACHE_H
+
+#include <SDL.h>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+class AvancezLib;
+
+class Sprite;
+
+class SoundEffect;
+
+class Music;
+
+/**
+ * Loads each sprite, sound and music file once and hands out shared handles to it, so scenes and
+ * objects asking again for the same path get the already decoded asset.
+ *
+ * The cache keeps a reference to every asset. Once the cache is over its memory budget, the least
+ * recently requested assets nobody else holds are freed (they are loaded again if requested later).
+ *
+ * The methods can be called from any thread, so levels can be loaded in the background. Files are
+ * decoded without holding the lock, the main thread is never stalled by a loading thread. Freeing a
+ * sound stops its voices, so assets are only evicted on the thread which created the cache.
+ */
+class AssetCache {
+public:
+    void Create(AvancezLib *engine, size_t budget_bytes);
+
+    // Frees all the assets, the ones still held elsewhere are freed when released
+    void Destroy();
+
+    std::shared_ptr<Sprite> GetSprite(const std::string &path);
+
+    /** The instances limit and priority are only used the first time the sound is loaded */
+    std::shared_ptr<SoundEffect> GetSound(const std::string &path, int max_instances = 4, int priority = 0);
+
+    std::shared_ptr<Music> GetMusic(const std::string &path);
+
+    // Load the assets ahead of time, i.e. during a transition, so asking for them later does not stall
+    void PreloadSprites(std::initializer_list<const char *> paths);
+
+    void PreloadSounds(std::initializer_list<const char *> paths, int max_instances = 4, int priority = 0);
+
+    void PreloadMusic(std::initializer_list<const char *> paths);
+
+    // Frees the least recently used assets nobody holds until the cache fits in the budget
+    void Trim();
+
+    void SetBudget(size_t budget_bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        budget = budget_bytes;
+        TrimLocked();
+    }
+
+    // Estimated memory of the assets in the cache
+    [[nodiscard]] size_t GetUsedBytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return used;
+    }
+
+private:
+    template<class T>
+    struct Entry {
+        std::shared_ptr<T> asset;
+        size_t bytes;
+        Uint64 lastUse;
+    };
+
+    template<class T>
+    using Entries = std::unordered_map<std::string, Entry<T>>;
+
+    template<class T>
+    std::shared_ptr<T> Touch(Entries<T> &entries, const std::string &path);
+
+    // Returns the asset already in the cache if another thread loaded the same path meanwhile
+    template<class T>
+    std::shared_ptr<T> Insert(Entries<T> &entries, const std::string &path, std::shared_ptr<T> asset, size_t bytes);
+
+    void TrimLocked();
+
+    // Oldest entry of the map not held outside the cache, returns false if there is none
+    template<class T>
+    bool FindEvictable(Entries<T> &entries, typename Entries<T>::iterator &oldest);
+
+    std::mutex mutex;
+    std::thread::id mainThread;
+    AvancezLib *engine = nullptr;
+    size_t budget = 0;
+    size_t used = 0;
+    Uint64 clock = 0;
+    Entries<Sprite> sprites;
+    Entries<SoundEffect> sounds;
+    Entries<Music> music;
+};
+
+#endif //CONTRA_ASSET_CACHE_H
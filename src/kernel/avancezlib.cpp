@@ -1,52 +1,61 @@
 #include "avancezlib.h"
 #include <SDL_image.h>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include "sdl_render_backend.h"
+#include "software_render_backend.h"
+
+const int FONT_SIZE = 32;
+// Mixer channels shared by all the sound effects
+const int SOUND_VOICES = 24;
+// Memory budget of the asset cache, the assets in use are never freed
+const size_t ASSETS_BUDGET = 96 * 1024 * 1024;
+// Pixels sent to the render backend ahead of drawing per frame, bigger textures still go one per frame
+const size_t UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024;
+
+static int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
 
-std::unordered_map<int, unsigned int> current_sound_ids;
-unsigned int next_sound_id = 1;
-
-void channel_finished_callback(int channel) {
-    current_sound_ids[channel] = 0;
-}
-
-std::function<void()> SoundEffect::Play(short times) {
-    if (effect) {
-        int channel = Mix_PlayChannel(-1, effect, times - 1);
-        if (channel >= 0) {
-            int sound_id = next_sound_id++;
-            current_sound_ids[channel] = sound_id;
-            return [channel, sound_id]() {
-                if (current_sound_ids[channel] == sound_id) {
-                    Mix_HaltChannel(channel);
-                }
-            };
-        } else {
-            int channels = Mix_AllocateChannels(-1);
-            if (channels < 100) {
-                Mix_AllocateChannels(channels + 1);
-                Mix_Volume(channels, Mix_Volume(channels - 1, -1));
-                Mix_PlayChannel(channels, effect, times - 1); // 0-based
-                SDL_Log("Audio Mixer: channels increased to %d", channels + 1);
-            }
-        }
-    }
-    return []() {};
+/**
+ * Positions are floored to the native pixel containing them and sizes are divided, so sprites keep
+ * their exact native size wherever they are drawn
+ */
+static SDL_Rect nativeRect(int x, int y, int w, int h, int zoom) {
+    return {floorDiv(x, zoom), floorDiv(y, zoom), (w + zoom / 2) / zoom, (h + zoom / 2) / zoom};
 }
 
 // Creates the main window. Returns true on success.
-bool AvancezLib::init(int width, int height) {
+bool AvancezLib::init(int width, int height, const RenderSettings &settings) {
     SDL_Log("Initializing the engine...\n");
 
-    if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
+    Uint32 subsystems = SDL_INIT_EVERYTHING;
+    if (settings.headless) {
+        // No display nor audio device may be available, i.e. in CI machines
+        subsystems = SDL_INIT_TIMER | SDL_INIT_AUDIO | SDL_INIT_EVENTS;
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    }
+    if (SDL_Init(subsystems) < 0) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL failed the initialization: %s\n", SDL_GetError());
         return false;
     }
 
+    pixelsZoom = settings.pixelsZoom;
+    nativeWidth = width / pixelsZoom;
+    nativeHeight = height / pixelsZoom;
+    int window_scale = settings.windowScale > 0 ? settings.windowScale : pixelsZoom;
+
     //Create window
-    window = SDL_CreateWindow("aVANCEZ", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height,
-            SDL_WINDOW_SHOWN);
-    if (window == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Window could not be created! SDL_Error: %s\n", SDL_GetError());
-        return false;
+    window = NULL;
+    if (!settings.headless) {
+        window = SDL_CreateWindow("aVANCEZ", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                nativeWidth * window_scale, nativeHeight * window_scale, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+        if (window == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Window could not be created! SDL_Error: %s\n",
+                    SDL_GetError());
+            return false;
+        }
     }
 
     //Initialize PNG loading
@@ -57,40 +66,62 @@ bool AvancezLib::init(int width, int height) {
         return false;
     }
 
-    //Create renderer for window
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (renderer == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Renderer could not be created! SDL Error: %s\n", SDL_GetError());
-        return false;
+    if (settings.captureFolder) {
+        capture.Create(nativeWidth, nativeHeight, settings.captureFolder, settings.captureFormat);
+        capture.SetEnabled(settings.captureOnStart);
+    }
+    debugDraw.SetEnabled(settings.debugDraw);
+
+    // The renderer is owned by the render backend, created on the render thread if threaded
+    if (settings.headless) {
+        // Rendered in order on this thread, no frame can be skipped
+        backend = std::make_unique<SoftwareRenderBackend>(nativeWidth, nativeHeight, settings.frameHashLog,
+                settings.frameDumpFolder);
+        backend->SetCapture(&capture);
+        if (!renderThread.Start(backend.get(), false)) {
+            return false;
+        }
+    } else {
+        backend = std::make_unique<SDLRenderBackend>(window, nativeWidth, nativeHeight);
+        backend->SetCapture(&capture);
+        if (!renderThread.Start(backend.get(), settings.threaded)) {
+            return false;
+        }
     }
 
     TTF_Init();
-    font = TTF_OpenFont("data/contra-famicom-nes.ttf", 32); //this opens a font style and sets a size
+    // The font is rasterized at native resolution, as everything else
+    font = TTF_OpenFont("data/contra-famicom-nes.ttf", SDL_max(1, FONT_SIZE / pixelsZoom));
     if (font == NULL) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "font cannot be created! SDL_Error: %s\n", SDL_GetError());
         return false;
     }
+    // Glyphs are rasterized only once, text is drawn from the atlas afterwards
+    if (!textAtlas.Create(font)) {
+        return false;
+    }
 
     // initialize the keys
     key.fire = false;
     key.left = false;
     key.right = false, key.esc = false;
 
-    //Initialize renderer color
-    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0x00);
-
-    //Clear screen
-    SDL_RenderClear(renderer);
-
     //Initialize SDL_mixer
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
         printf("SDL_mixer could not initialize! SDL_mixer Error: %s\n", Mix_GetError());
     } else {
-        Mix_AllocateChannels(25); // start with 25 channels
-        Mix_ChannelFinished(channel_finished_callback);
+        voices.Create(SOUND_VOICES);
         audioOpen = true;
     }
 
+    assets.Create(this, ASSETS_BUDGET);
+
+    // Last, so no worker is left running if something above fails. The headless runs have to be reproducible.
+    int workers = settings.jobWorkers;
+    if (workers < 0)
+        workers = settings.headless ? 0 : JobSystem::DefaultWorkers();
+    jobs.Start(workers);
+
     SDL_Log("Engine up and running...\n");
     return true;
 }
@@ -100,10 +131,22 @@ bool AvancezLib::init(int width, int height) {
 void AvancezLib::destroy() {
     SDL_Log("Shutting down the engine\n");
 
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    jobs.Stop();
+    assets.Destroy();
+    textAtlas.Destroy(renderThread);
+    pendingUploads.clear();
+    for (auto *page : atlasPages)
+        renderThread.Retire(page);
+    atlasPages.clear();
+    renderThread.Stop();
+    backend.reset();
+    capture.Destroy();
+    if (window)
+        SDL_DestroyWindow(window);
 
     TTF_CloseFont(font);
+    if (audioOpen)
+        voices.Destroy();
 
     TTF_Quit();
     SDL_Quit();
@@ -117,6 +160,9 @@ void AvancezLib::quit() {
 
 void AvancezLib::processInput() {
     SDL_Event event;
+    voices.BeginFrame();
+    // SDL calls requested by the jobs
+    jobs.RunMainThreadJobs();
 
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_KEYDOWN) {
@@ -179,6 +225,19 @@ void AvancezLib::processInput() {
                 case SDLK_RETURN:
                     key.start = true;
                     break;
+                case SDLK_F12:
+                    if (!event.key.repeat)
+                        capture.Toggle();
+                    break;
+                case SDLK_F1:
+                case SDLK_F2:
+                case SDLK_F3:
+                case SDLK_F4:
+                case SDLK_F5:
+                    // One debug overlay category per key, in the order they are declared
+                    if (!event.key.repeat)
+                        debugDraw.Toggle(DebugDraw::Category(1 << (event.key.keysym.sym - SDLK_F1)));
+                    break;
             }
         }
 
@@ -248,17 +307,74 @@ void AvancezLib::processInput() {
 }
 
 void AvancezLib::swapBuffers() {
-    //Update screen
-    SDL_RenderPresent(renderer);
+    debugDraw.Flush(renderThread.GetBackList(), textAtlas);
+    flushUploads(renderThread.GetBackList());
+    // The frame is handed to the render thread, which upscales and presents it
+    renderThread.Submit();
 }
 
 void AvancezLib::clearWindow() {
-    //Clear screen
-    SDL_RenderClear(renderer);
+    // Discards what has been drawn so far, every frame is rendered on a cleared target anyway
+    renderThread.GetBackList().Clear();
+}
+
+int AvancezLib::getDisplayRefreshRate() {
+    SDL_DisplayMode mode;
+    if (!window || SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(window), &mode) != 0)
+        return 0;
+    return mode.refresh_rate;
 }
 
+void AvancezLib::setWindowScale(int scale) {
+    if (window && scale > 0)
+        SDL_SetWindowSize(window, nativeWidth * scale, nativeHeight * scale);
+}
+
+SDL_Rect AvancezLib::toNative(int x, int y, int w, int h) const {
+    return nativeRect(x, y, w, h, pixelsZoom);
+}
+
+
+bool AvancezLib::loadAtlas(const char *path) {
+    SDL_RWops *file = SDL_RWFromFile(path, "r");
+    if (file == NULL) {
+        SDL_Log("Atlas %s not found, sprites will be loaded separately", path);
+        return false;
+    }
+    std::string table(SDL_RWsize(file), '\0');
+    SDL_RWread(file, table.data(), 1, table.size());
+    SDL_RWclose(file);
+
+    std::istringstream lines(table);
+    std::string type, source;
+    AtlasRegion region;
+    while (lines >> type) {
+        if (type == "page") {
+            lines >> source;
+            SDL_Surface *surf = IMG_Load(source.c_str());
+            if (surf == NULL) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load atlas page %s! SDL_image Error: %s\n",
+                        source.c_str(), IMG_GetError());
+                return false;
+            }
+            atlasPages.push_back(new Texture(surf));
+            queueUpload(atlasPages.back());
+        } else if (type == "sprite") {
+            lines >> source >> region.page >> region.rect.x >> region.rect.y >> region.rect.w >> region.rect.h;
+            if (region.page >= 0 && size_t(region.page) < atlasPages.size())
+                atlasRegions[source] = region;
+        }
+    }
+    SDL_Log("Atlas %s: %d sprites in %d pages", path, (int) atlasRegions.size(), (int) atlasPages.size());
+    return true;
+}
 
 Sprite *AvancezLib::createSprite(const char *path) {
+    auto region = atlasRegions.find(path);
+    if (region != atlasRegions.end()) {
+        return new Sprite(this, atlasPages[region->second.page], region->second.rect);
+    }
+
     SDL_Surface *surf = IMG_Load(path);
     if (surf == NULL) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s! SDL_image Error: %s\n", path,
@@ -266,28 +382,53 @@ Sprite *AvancezLib::createSprite(const char *path) {
         return NULL;
     }
 
-    //Create texture from surface pixels
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surf);
-    if (texture == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture from %s! SDL Error: %s\n", path,
-                SDL_GetError());
-        return NULL;
-    }
-    //Get rid of old loaded surface
-    SDL_FreeSurface(surf);
-    Sprite *sprite = new Sprite(renderer, texture);
+    // The texture is created from the surface pixels by the render backend, ahead of time or when first drawn
+    auto *texture = new Texture(surf);
+    queueUpload(texture);
+    Sprite *sprite = new Sprite(this, texture);
     return sprite;
 }
 
-void AvancezLib::drawText(int x, int y, const char *msg, SDL_Color color, const TextAlign textAlign) {
-    SDL_Surface *surf = TTF_RenderText_Solid(font, msg, color);
-    // as TTF_RenderText_Solid could only be used on SDL_Surface then you have to create the surface first
+void AvancezLib::releaseTexture(Texture *texture) {
+    {
+        std::lock_guard<std::mutex> lock(uploadsMutex);
+        pendingUploads.erase(std::remove(pendingUploads.begin(), pendingUploads.end(), texture),
+                             pendingUploads.end());
+    }
+    renderThread.Retire(texture);
+}
+
+void AvancezLib::queueUpload(Texture *texture) {
+    std::lock_guard<std::mutex> lock(uploadsMutex);
+    pendingUploads.push_back(texture);
+}
+
+void AvancezLib::flushUploads(DrawList &list) {
+    std::lock_guard<std::mutex> lock(uploadsMutex);
+    size_t bytes = 0;
+    while (!pendingUploads.empty()) {
+        Texture *texture = pendingUploads.front();
+        size_t texture_bytes = size_t(texture->width) * texture->height * 4;
+        if (!list.uploads.empty() && bytes + texture_bytes > UPLOAD_BYTES_PER_FRAME)
+            break;
+        // If the frame is skipped by the render thread the texture is just uploaded when first drawn
+        list.uploads.push_back(texture);
+        bytes += texture_bytes;
+        pendingUploads.pop_front();
+    }
+}
 
-    SDL_Texture *msg_texture = SDL_CreateTextureFromSurface(renderer, surf); //now you can convert it into a texture
+size_t AvancezLib::getPendingUploads() {
+    std::lock_guard<std::mutex> lock(uploadsMutex);
+    return pendingUploads.size();
+}
 
-    int w = 0;
-    int h = 0;
-    SDL_QueryTexture(msg_texture, NULL, NULL, &w, &h);
+void AvancezLib::drawText(int x, int y, const char *msg, SDL_Color color, const TextAlign textAlign) {
+    SDL_Rect position = toNative(x, y, 0, 0);
+    x = position.x;
+    y = position.y;
+    int w = textAtlas.MeasureWidth(msg);
+    int h = textAtlas.GetLineHeight();
     if (textAlign == TEXT_ALIGN_CENTER_TOP
         || textAlign == TEXT_ALIGN_CENTER_MIDDLE
         || textAlign == TEXT_ALIGN_CENTER_BOTTOM) {
@@ -306,38 +447,47 @@ void AvancezLib::drawText(int x, int y, const char *msg, SDL_Color color, const
                || textAlign == TEXT_ALIGN_RIGHT_BOTTOM) {
         y -= h;
     }
-    SDL_Rect dst_rect = {x, y, w, h};
 
-    SDL_RenderCopy(renderer, msg_texture, NULL, &dst_rect);
-
-    SDL_DestroyTexture(msg_texture);
-    SDL_FreeSurface(surf);
+    textAtlas.Draw(renderThread.GetBackList(), x, y, msg, color);
 }
 
 void AvancezLib::fillSquare(int x, int y, int side, SDL_Color color) {
-    SDL_Rect rect;
-    rect.x = x;
-    rect.y = y;
-    rect.w = side;
-    rect.h = side;
-
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(renderer, &rect);
-
-    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 255);
+    SDL_Rect rect = toNative(x, y, side, side);
+    rect.w = SDL_max(1, rect.w);
+    rect.h = SDL_max(1, rect.h);
+    renderThread.GetBackList().AddRect(DrawCommand::FILL_RECT, rect, color);
 }
 
 void AvancezLib::strokeSquare(int tl_x, int tl_y, int br_x, int br_y, SDL_Color color) {
-    SDL_Rect rect;
-    rect.x = tl_x;
-    rect.y = tl_y;
-    rect.w = br_x - tl_x;
-    rect.h = br_y - tl_y;
+    SDL_Rect tl = toNative(tl_x, tl_y, 0, 0);
+    SDL_Rect br = toNative(br_x, br_y, 0, 0);
+    SDL_Rect rect = {tl.x, tl.y, br.x - tl.x, br.y - tl.y};
+    renderThread.GetBackList().AddRect(DrawCommand::STROKE_RECT, rect, color);
+}
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderDrawRect(renderer, &rect);
+void AvancezLib::debugFillSquare(DebugDraw::Category category, int x, int y, int side, SDL_Color color) {
+    if (!debugDraw.IsEnabled(category))
+        return;
+    SDL_Rect rect = toNative(x, y, side, side);
+    rect.w = SDL_max(1, rect.w);
+    rect.h = SDL_max(1, rect.h);
+    debugDraw.FillRect(category, rect, color);
+}
+
+void AvancezLib::debugStrokeSquare(DebugDraw::Category category, int tl_x, int tl_y, int br_x, int br_y,
+                                   SDL_Color color) {
+    if (!debugDraw.IsEnabled(category))
+        return;
+    SDL_Rect tl = toNative(tl_x, tl_y, 0, 0);
+    SDL_Rect br = toNative(br_x, br_y, 0, 0);
+    debugDraw.StrokeRect(category, {tl.x, tl.y, br.x - tl.x, br.y - tl.y}, color);
+}
 
-    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 255);
+void AvancezLib::debugText(DebugDraw::Category category, int x, int y, const char *msg, SDL_Color color) {
+    if (!debugDraw.IsEnabled(category))
+        return;
+    SDL_Rect position = toNative(x, y, 0, 0);
+    debugDraw.Text(category, position.x, position.y, msg, color);
 }
 
 float AvancezLib::getElapsedTime() {
@@ -348,12 +498,12 @@ void AvancezLib::getKeyStatus(KeyStatus &keys) {
     memcpy(&keys, &key, sizeof(KeyStatus));
 }
 
-SoundEffect *AvancezLib::createSound(const char *path) {
+SoundEffect *AvancezLib::createSound(const char *path, int max_instances, int priority) {
     auto *sound = Mix_LoadWAV(path);
     if (!sound) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load sound! SDL_mixer Error: %s\n", Mix_GetError());
     }
-    return new SoundEffect(sound);
+    return new SoundEffect(sound, &voices, max_instances, priority);
 }
 
 Music *AvancezLib::createMusic(const char *path) {
@@ -383,45 +533,43 @@ void AvancezLib::ToggleMusic() {
 }
 
 
-Sprite::Sprite(SDL_Renderer *renderer, SDL_Texture *texture) {
-    this->renderer = renderer;
+Sprite::Sprite(AvancezLib *engine, Texture *texture) {
+    this->engine = engine;
     this->texture = texture;
+    this->region = {0, 0, texture->width, texture->height};
+    this->ownsTexture = true;
+}
+
+Sprite::Sprite(AvancezLib *engine, Texture *atlas, const SDL_Rect &region) {
+    this->engine = engine;
+    this->texture = atlas;
+    this->region = region;
+    this->ownsTexture = false;
 }
 
 
 void Sprite::draw(int x, int y) {
-    SDL_Rect rect;
-    rect.x = x;
-    rect.y = y;
-    SDL_QueryTexture(texture, NULL, NULL, &(rect.w), &(rect.h));
-    //Render texture to screen
-    SDL_RenderCopy(renderer, texture, NULL, &rect);
+    SDL_Rect dst = engine->toNative(x, y, 0, 0);
+    dst.w = region.w;
+    dst.h = region.h;
+    engine->getDrawList().AddTexture(texture, region, dst);
 }
 
 void Sprite::draw(int x, int y, int tw, int th, int sx, int sy, int sw, int sh, bool mirrorHorizontal) {
-    SDL_Rect tgtRect, srcRect;
-    tgtRect.x = x;
-    tgtRect.y = y;
-    tgtRect.w = tw;
-    tgtRect.h = th;
-
-    srcRect.x = sx;
-    srcRect.y = sy;
-    srcRect.w = sw;
-    srcRect.h = sh;
-    //Render texture to screen
-    if (mirrorHorizontal)
-        SDL_RenderCopyEx(renderer, texture, &srcRect, &tgtRect,
-                0, nullptr, SDL_FLIP_HORIZONTAL);
-    else SDL_RenderCopy(renderer, texture, &srcRect, &tgtRect);
+    engine->getDrawList().AddTexture(texture, {region.x + sx, region.y + sy, sw, sh},
+            engine->toNative(x, y, tw, th), mirrorHorizontal);
 }
 
 Sprite::~Sprite() {
-    SDL_DestroyTexture(texture);
+    // Pending frames may still draw it
+    if (ownsTexture)
+        engine->releaseTexture(texture);
 }
 
 int Sprite::getWidth() const {
-    int w;
-    SDL_QueryTexture(texture, nullptr, nullptr, &w, nullptr);
-    return w;
+    return region.w;
+}
+
+int Sprite::getHeight() const {
+    return region.h;
 }
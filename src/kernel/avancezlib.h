@@ -6,23 +6,46 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "asset_cache.h"
+#include "debug_draw.h"
+#include "glyph_atlas.h"
+#include "job_system.h"
+#include "render_thread.h"
+#include "voice_pool.h"
+
+class AvancezLib;
 
-void channel_finished_callback(int channel);
-
+/**
+ * Drawing a sprite only records it in the draw list of the frame, the texture is drawn later by the
+ * render thread at its native size in the frame render target.
+ */
 class Sprite {
-    SDL_Renderer *renderer;
-    SDL_Texture *texture;
+    AvancezLib *engine;
+    Texture *texture;
+    SDL_Rect region; // Part of the texture used by the sprite, all of it unless it is in an atlas
+    bool ownsTexture;
 public:
 
-    Sprite(SDL_Renderer *renderer, SDL_Texture *texture);
+    Sprite(AvancezLib *engine, Texture *texture);
+
+    // A sprite which is a region of an atlas owned by the engine
+    Sprite(AvancezLib *engine, Texture *atlas, const SDL_Rect &region);
 
     // Destroys the sprite instance
     ~Sprite();
 
     [[nodiscard]] int getWidth() const;
 
+    [[nodiscard]] int getHeight() const;
+
     // Draw the sprite at the given position.
     void draw(int x, int y);
 
@@ -63,25 +86,44 @@ private:
  */
 class SoundEffect final {
 public:
-    SoundEffect(Mix_Chunk *effect) : effect(effect) {}
+    /**
+     * @param max_instances Voices of this sound that can play at the same time
+     * @param priority Sounds with higher priority can steal the voices of the lower ones when all are in use
+     */
+    SoundEffect(Mix_Chunk *effect, VoicePool *voices, int max_instances = 4, int priority = 0)
+            : effect(effect), voices(voices), maxInstances(max_instances), priority(priority) {}
 
     /**
-     * Plays the sound and returns a callback which will stop the sound in case it is
-     * still playing when the callback is called. Set to 0 times to loop forever.
-     * If the current number of channels is not enough to support one sound
-     * more playing, new channels will be allocated.
+     * Plays the sound in a voice of the pool, see VoicePool for what happens when there
+     * are no voices left. Set to 0 times to loop forever.
      *
-     * @return A callback to Stop the channel (if it is still playing)
+     * @return A handle to Stop the sound (if it is still playing)
      */
-    std::function<void()> Play(short times = 1);
+    SoundHandle Play(short times = 1) {
+        return effect ? voices->Play(this, effect, times, maxInstances, priority) : SoundHandle();
+    }
+
+    void Stop(SoundHandle handle) {
+        voices->Stop(handle);
+    }
+
+    // Memory used by the decoded samples
+    [[nodiscard]] size_t GetBytes() const {
+        return effect ? effect->alen : 0;
+    }
 
     ~SoundEffect() {
-        if (effect)
+        if (effect) {
+            voices->StopAll(this);
             Mix_FreeChunk(effect);
+        }
     }
 
 private:
     Mix_Chunk *effect;
+    VoicePool *voices;
+    int maxInstances;
+    int priority;
 };
 
 
@@ -105,31 +147,89 @@ public:
     // Destroys the avancez library instance and exits
     void quit();
 
-    // Creates the main window. Returns true on success.
-    bool init(int width, int height);
+    struct RenderSettings {
+        // Size of a native pixel in drawing coordinates
+        int pixelsZoom = 1;
+        // Initial size of the window in times the native resolution, 0 to use pixelsZoom.
+        // The window can be resized afterwards, the frame is scaled by the biggest integer that fits.
+        int windowScale = 0;
+        // Renders and presents the frames in their own thread, if false they are rendered by swapBuffers
+        bool threaded = true;
+        // Rasterizes the frames on the CPU without any window, every frame is rendered by swapBuffers
+        bool headless = false;
+        // Headless only, file where the hash of every frame is written
+        const char *frameHashLog = nullptr;
+        // Headless only, folder where every frame is saved as a BMP image
+        const char *frameDumpFolder = nullptr;
+        // Folder where the frames are saved while the capture is on (toggled with F12), nullptr to disable
+        const char *captureFolder = nullptr;
+        FrameCapture::Format captureFormat = FrameCapture::PNG;
+        // Start capturing from the first frame
+        bool captureOnStart = false;
+        // Worker threads of the job system, 0 runs the jobs serially (the default when headless), -1 one per core
+        int jobWorkers = -1;
+        // DebugDraw categories shown from the start, F1-F5 toggle each of them while playing
+#ifndef NDEBUG
+        Uint8 debugDraw = DebugDraw::DEBUG_COLLIDERS | DebugDraw::DEBUG_ANCHORS | DebugDraw::DEBUG_STATS;
+#else
+        Uint8 debugDraw = 0;
+#endif
+    };
+
+    /**
+     * Creates the main window. Returns true on success.
+     * The frame is rendered at native resolution (width / pixelsZoom x height / pixelsZoom) in an
+     * offscreen target and upscaled once to the window when presenting, while all the drawing
+     * methods keep receiving coordinates in the width x height space.
+     */
+    bool init(int width, int height, const RenderSettings &settings);
+
+    // Resizes the window to the given number of times the native resolution
+    void setWindowScale(int scale);
+
+    // Refresh rate of the display showing the window, 0 if unknown (or headless)
+    int getDisplayRefreshRate();
 
     // Clears the screen and draws all sprites and texts which have been drawn
     // since the last update call.
     // If update returns false, the application should terminate.
     void processInput();
 
+    // Submits the frame drawn since the last call to be upscaled to the window and presented
     void swapBuffers();
 
     void clearWindow();
 
-    // Create a sprite given a string.
-    // All sprites are 32*32 pixels.
+    /**
+     * Loads the remap table and pages written by the atlas packer. Sprites created afterwards from
+     * an image packed in the atlas are regions of its page, so they are all drawn from the same
+     * texture and keep using the coordinates of the original image.
+     * @return False if the atlas could not be loaded, sprites are then loaded as separate textures
+     */
+    bool loadAtlas(const char *path);
+
+    // Create a sprite given a string. Safe to call from a loading thread, only the image is decoded.
     Sprite *createSprite(const char *name);
 
+    // Textures created but not handed to the render backend yet, they are sent a few per frame
+    size_t getPendingUploads();
+
+    // Cache of the loaded sprites, sounds and music, prefer it to the create methods for shared assets
+    AssetCache &getAssets() { return assets; }
+
+    // Runs work on the worker threads, the jobs queued for the main thread are run by processInput
+    JobSystem &getJobs() { return jobs; }
+
     Music *createMusic(const char *path);
 
-    SoundEffect *createSound(const char *path);
+    // See SoundEffect for the instances limit and the priority
+    SoundEffect *createSound(const char *path, int max_instances = 4, int priority = 0);
 
     bool isMusicPlaying() { return Mix_PlayingMusic(); }
     void StopMusic() {Mix_HaltMusic();}
     void FadeOutMusic(int ms = 1000);
 
-    // Draws the given text.
+    // Draws the given text using the glyph atlas, no font rasterization happens here.
     void drawText(int x, int y, const char *msg, SDL_Color color = {255, 255, 255},
                   const TextAlign textAlign = TEXT_ALIGN_LEFT_TOP);
 
@@ -138,6 +238,20 @@ public:
 
     void strokeSquare(int tl_x, int tl_y, int br_x, int br_y, SDL_Color color);
 
+    // The debug overlay, flushed on top of the frame by swapBuffers
+    DebugDraw &getDebugDraw() { return debugDraw; }
+
+    [[nodiscard]] bool isDebugEnabled(DebugDraw::Category category) const {
+        return debugDraw.IsEnabled(category);
+    }
+
+    // Same as fillSquare, strokeSquare and drawText but in the debug overlay, only if the category is enabled
+    void debugFillSquare(DebugDraw::Category category, int x, int y, int side, SDL_Color color);
+
+    void debugStrokeSquare(DebugDraw::Category category, int tl_x, int tl_y, int br_x, int br_y, SDL_Color color);
+
+    void debugText(DebugDraw::Category category, int x, int y, const char *msg, SDL_Color color = {255, 255, 255});
+
     // Return the total time spent in the game, in seconds.
     float getElapsedTime();
 
@@ -170,12 +284,46 @@ public:
 
     void ToggleMusic();
 
+    // Converts a rect in drawing coordinates to native pixels of the frame target
+    [[nodiscard]] SDL_Rect toNative(int x, int y, int w, int h) const;
+
+    // The draw list of the frame being recorded
+    DrawList &getDrawList() { return renderThread.GetBackList(); }
+
+    // Releases the texture once the frames drawing it have been rendered. Can be called from any thread.
+    void releaseTexture(Texture *texture);
+
 private:
+    // Queues the texture to be uploaded ahead of being drawn, can be called from any thread
+    void queueUpload(Texture *texture);
+
+    // Moves the queued textures fitting in the per frame budget to the frame being submitted
+    void flushUploads(DrawList &list);
+
+    struct AtlasRegion {
+        int page;
+        SDL_Rect rect;
+    };
+
     SDL_Window *window;
-    SDL_Renderer *renderer;
+    std::unique_ptr<RenderBackend> backend;
+    FrameCapture capture;
+    VoicePool voices;
+    AssetCache assets;
+    JobSystem jobs;
+    std::vector<Texture *> atlasPages;
+    std::unordered_map<std::string, AtlasRegion> atlasRegions;
+    RenderThread renderThread;
+    std::mutex uploadsMutex;
+    std::deque<Texture *> pendingUploads;
+    int pixelsZoom = 1;
+    int nativeWidth = 0;
+    int nativeHeight = 0;
     bool audioOpen = false;
 
     TTF_Font *font;
+    GlyphAtlas textAtlas;
+    DebugDraw debugDraw;
 
     KeyStatus key;
 };
@@ -2,6 +2,7 @@
 
 #include <SDL_log.h>
 #include "game_object.h"
+#include "arena.h"
 
 
 class BaseScene;
@@ -13,6 +14,17 @@ protected:
 public:
     virtual ~Component() {}
 
+    // Allocated in the current arena of the thread, if any (see Arena)
+    static void *operator new(size_t size) {
+        return Arena::Allocate(size, Arena::COMPONENTS, [](void *component) {
+            static_cast<Component *>(component)->~Component();
+        });
+    }
+
+    static void operator delete(void *memory) {
+        Arena::Free(memory);
+    }
+
     virtual void Create(BaseScene *scene, GameObject *go) {
         this->scene = scene;
         this->go = go;
@@ -31,12 +43,21 @@ public:
         return go->GetComponent<T>();
     }
 
+    /**
+     * Hookup called when the game object is taken again from a pool, before Init, to forget what was
+     * changed during its last use (i.e. pending messages or the animation frame)
+     */
+    virtual void Reset() {}
+
     /** Hookup called when the associated game object has just been enabled */
     virtual void OnGameObjectEnabled() {}
 
     /** Hookup called when the associated game object is disabled */
     virtual void OnGameObjectDisabled() {}
 
+    /** Hookup called when the scene stops updating the associated game object until it wakes up */
+    virtual void OnGameObjectAsleep() {}
+
     [[nodiscard]] GameObject *GetGameObject() const { return go; }
 
     virtual void Update(float dt) = 0;
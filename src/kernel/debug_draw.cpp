@@ -0,0 +1,58 @@
+#include "debug_draw.h"
+#include <algorithm>
+#include "glyph_atlas.h"
+
+void DebugDraw::FillRect(Category category, const SDL_Rect &rect, SDL_Color color) {
+    if (!IsEnabled(category) || rect.w <= 0 || rect.h <= 0)
+        return;
+    const Uint32 packed = (Uint32(color.r) << 24) | (Uint32(color.g) << 16) | (Uint32(color.b) << 8) | color.a;
+    quads.push_back({packed, rect});
+}
+
+void DebugDraw::StrokeRect(Category category, const SDL_Rect &rect, SDL_Color color) {
+    if (!IsEnabled(category) || rect.w <= 0 || rect.h <= 0)
+        return;
+    // Outlines become four one pixel wide quads, so everything is drawn with the same batches
+    FillRect(category, {rect.x, rect.y, rect.w, 1}, color);
+    FillRect(category, {rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    FillRect(category, {rect.x, rect.y, 1, rect.h}, color);
+    FillRect(category, {rect.x + rect.w - 1, rect.y, 1, rect.h}, color);
+}
+
+void DebugDraw::Text(Category category, int x, int y, const char *text, SDL_Color color) {
+    if (!IsEnabled(category))
+        return;
+    if (labelCount == (int) labels.size())
+        labels.emplace_back();
+    Label &label = labels[labelCount++];
+    label.x = x;
+    label.y = y;
+    label.color = color;
+    label.text = text;
+}
+
+void DebugDraw::Flush(DrawList &list, const GlyphAtlas &atlas) {
+    if (!quads.empty()) {
+        std::stable_sort(quads.begin(), quads.end(), [](const Quad &a, const Quad &b) {
+            return a.color < b.color;
+        });
+        size_t start = 0;
+        while (start < quads.size()) {
+            size_t end = start;
+            const auto first = (int) list.rects.size();
+            while (end < quads.size() && quads[end].color == quads[start].color) {
+                list.rects.push_back(quads[end].rect);
+                end++;
+            }
+            const Uint32 packed = quads[start].color;
+            list.AddRects(first, int(end - start), {Uint8(packed >> 24), Uint8(packed >> 16),
+                                                    Uint8(packed >> 8), Uint8(packed)});
+            start = end;
+        }
+        quads.clear();
+    }
+    for (int i = 0; i < labelCount; i++) {
+        atlas.Draw(list, labels[i].x, labels[i].y, labels[i].text.c_str(), labels[i].color);
+    }
+    labelCount = 0;
+}
@@ -0,0 +1,74 @@
+#ifndef CONTRA_DEBUG_DRAW_H
+#define CONTRA_DEBUG_DRAW_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "draw_list.h"
+
+class GlyphAtlas;
+
+/**
+ * Debug overlay drawn on top of the frame. The primitives of the enabled categories are recorded
+ * during the frame in a quad buffer and flushed at the end of it into the draw list, grouped by
+ * colour so each group is a single batched draw. Categories can be toggled at runtime, when one is
+ * off recording it costs a bit test.
+ */
+class DebugDraw {
+public:
+    enum Category : Uint8 {
+        DEBUG_COLLIDERS = 1 << 0, // Collider boxes
+        DEBUG_ANCHORS = 1 << 1, // Position of the rendered objects
+        DEBUG_STATS = 1 << 2, // FPS and frame stats
+        DEBUG_GRID = 1 << 3, // Occupancy of the collision grid cells
+        DEBUG_POOLS = 1 << 4 // Usage of the object pools
+    };
+    static const int CATEGORIES = 5;
+
+    [[nodiscard]] bool IsEnabled(Category category) const {
+        return (enabled & category) != 0;
+    }
+
+    // Nothing is recorded if no category is enabled
+    [[nodiscard]] bool IsAnyEnabled() const {
+        return enabled != 0;
+    }
+
+    void SetEnabled(Uint8 categories) {
+        enabled = categories;
+    }
+
+    void Toggle(Category category) {
+        enabled ^= category;
+        SDL_Log("Debug overlay category %d %s", category, IsEnabled(category) ? "on" : "off");
+    }
+
+    // All the rects are in native pixels of the frame
+    void FillRect(Category category, const SDL_Rect &rect, SDL_Color color);
+
+    void StrokeRect(Category category, const SDL_Rect &rect, SDL_Color color);
+
+    void Text(Category category, int x, int y, const char *text, SDL_Color color = {255, 255, 255, 255});
+
+    // Appends everything recorded to the list, after the rest of the frame, and clears the buffers
+    void Flush(DrawList &list, const GlyphAtlas &atlas);
+
+private:
+    struct Quad {
+        Uint32 color; // RGBA packed, the sort key of the batches
+        SDL_Rect rect;
+    };
+
+    struct Label {
+        int x, y;
+        SDL_Color color;
+        std::string text;
+    };
+
+    Uint8 enabled = 0;
+    std::vector<Quad> quads;
+    std::vector<Label> labels;
+    int labelCount = 0; // Labels used this frame, the strings are kept to reuse their memory
+};
+
+#endif //CONTRA_DEBUG_DRAW_H
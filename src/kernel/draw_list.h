@@ -0,0 +1,73 @@
+#ifndef CONTRA_DRAW_LIST_H
+#define CONTRA_DRAW_LIST_H
+
+#include <SDL.h>
+#include <vector>
+
+/**
+ * Image data shared between the simulation, which only knows its size, and the render backend,
+ * which turns the surface into whatever it needs (i.e. an SDL_Texture) the first time it is drawn.
+ * It is never deleted directly, the owner hands it to the render thread to be released once no
+ * pending frame can reference it anymore.
+ */
+struct Texture {
+    SDL_Surface *surface; // Decoded pixels, the backend may free them once uploaded
+    SDL_Texture *texture = nullptr; // Owned and only accessed by the render backend
+    int width;
+    int height;
+
+    explicit Texture(SDL_Surface *surface) : surface(surface), width(surface->w), height(surface->h) {}
+};
+
+/**
+ * A single draw operation, all rects are in native pixels of the frame
+ */
+struct DrawCommand {
+    enum Type : Uint8 {
+        TEXTURE,
+        FILL_RECT,
+        STROKE_RECT,
+        FILL_RECTS // src.w rects of the same colour starting at src.x in DrawList::rects
+    };
+
+    Type type;
+    bool mirrorHorizontal;
+    SDL_Color color; // Draw colour of the rects or tint of the texture
+    Texture *texture;
+    SDL_Rect src;
+    SDL_Rect dst;
+};
+
+/**
+ * Everything drawn during one frame. Once submitted it is not modified anymore, the render thread
+ * reads it while the simulation records the next frame in another list.
+ */
+struct DrawList {
+    std::vector<DrawCommand> commands;
+    std::vector<SDL_Rect> rects; // Rects of the FILL_RECTS batches
+    // Textures the backend prepares before drawing, so loading a scene spreads the uploads over frames
+    std::vector<Texture *> uploads;
+    Uint64 frame = 0;
+
+    void Clear() {
+        commands.clear(); // Keeps the capacity, no allocations after the first frames
+        rects.clear();
+        uploads.clear();
+    }
+
+    void AddTexture(Texture *texture, const SDL_Rect &src, const SDL_Rect &dst, bool mirror_horizontal = false,
+                    SDL_Color tint = {255, 255, 255, 255}) {
+        commands.push_back({DrawCommand::TEXTURE, mirror_horizontal, tint, texture, src, dst});
+    }
+
+    void AddRect(DrawCommand::Type type, const SDL_Rect &dst, SDL_Color color) {
+        commands.push_back({type, false, color, nullptr, {0, 0, 0, 0}, dst});
+    }
+
+    // Adds a batch of count rects, already in rects from first on
+    void AddRects(int first, int count, SDL_Color color) {
+        commands.push_back({DrawCommand::FILL_RECTS, false, color, nullptr, {first, 0, count, 0}, {0, 0, 0, 0}});
+    }
+};
+
+#endif //CONTRA_DRAW_LIST_H
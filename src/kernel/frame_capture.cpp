@@ -0,0 +1,129 @@
+#include "frame_capture.h"
+#include <SDL_image.h>
+
+void FrameCapture::Create(int width, int height, const char *folder, Format format, int buffers, int encoders) {
+    this->width = width;
+    this->height = height;
+    this->folder = folder;
+    this->format = format;
+    slots = std::vector<Slot>(SDL_max(1, buffers));
+    for (auto &slot : slots)
+        slot.pixels.resize(size_t(width) * height);
+    pending.assign(slots.size(), 0);
+    pendingStart = pendingCount = 0;
+    next = 0;
+
+    running = true;
+    for (int i = 0; i < SDL_max(1, encoders); i++)
+        this->encoders.emplace_back(&FrameCapture::EncoderLoop, this);
+}
+
+void FrameCapture::Destroy() {
+    enabled = false;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        running = false;
+    }
+    pendingCondition.notify_all();
+    for (auto &encoder : encoders)
+        encoder.join();
+    encoders.clear();
+    slots.clear();
+    if (captured > 0)
+        SDL_Log("Frame capture: %llu frames saved, %llu dropped", (unsigned long long) captured.load(),
+                (unsigned long long) dropped.load());
+}
+
+void FrameCapture::SetEnabled(bool enabled) {
+    if (slots.empty())
+        return;
+    this->enabled = enabled;
+    SDL_Log("Frame capture %s (%llu frames saved, %llu dropped)", enabled ? "started" : "stopped",
+            (unsigned long long) captured.load(), (unsigned long long) dropped.load());
+}
+
+Uint32 *FrameCapture::BeginFrame(Uint64 frame) {
+    if (!IsEnabled())
+        return nullptr;
+    Slot &slot = slots[next];
+    int expected = FREE;
+    if (!slot.state.compare_exchange_strong(expected, FILLING, std::memory_order_acquire)) {
+        dropped++;
+        return nullptr;
+    }
+    slot.frame = frame;
+    return slot.pixels.data();
+}
+
+void FrameCapture::EndFrame() {
+    Slot &slot = slots[next];
+    slot.state.store(PENDING, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending[(pendingStart + pendingCount) % pending.size()] = next;
+        pendingCount++;
+    }
+    pendingCondition.notify_one();
+    next = (next + 1) % int(slots.size());
+    captured++;
+}
+
+void FrameCapture::EncoderLoop() {
+    // Conversion buffer of this encoder, reused for every frame it encodes
+    std::vector<Uint8> yuv;
+    while (true) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex);
+            // The frames still pending when stopping are encoded before leaving
+            pendingCondition.wait(lock, [this]() { return pendingCount > 0 || !running; });
+            if (pendingCount == 0)
+                return;
+            index = pending[pendingStart];
+            pendingStart = (pendingStart + 1) % int(pending.size());
+            pendingCount--;
+        }
+        Encode(slots[index], yuv);
+        slots[index].state.store(FREE, std::memory_order_release);
+    }
+}
+
+void FrameCapture::Encode(const Slot &slot, std::vector<Uint8> &yuv) const {
+    char name[32];
+    snprintf(name, sizeof(name), "/frame_%06llu.%s", (unsigned long long) slot.frame, format == PNG ? "png" : "yuv");
+    const std::string path = folder + name;
+
+    if (format == PNG) {
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom((void *) slot.pixels.data(), width, height, 32,
+                                                                  width * 4, SDL_PIXELFORMAT_ARGB8888);
+        if (IMG_SavePNG(surface, path.c_str()) < 0)
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to save %s: %s", path.c_str(), IMG_GetError());
+        SDL_FreeSurface(surface);
+        return;
+    }
+
+    // Raw I420 (BT.601), the chroma planes are subsampled by 2 in both directions
+    const int chroma_w = (width + 1) / 2, chroma_h = (height + 1) / 2;
+    yuv.resize(size_t(width) * height + 2 * size_t(chroma_w) * chroma_h);
+    Uint8 *y_plane = yuv.data();
+    Uint8 *u_plane = y_plane + size_t(width) * height;
+    Uint8 *v_plane = u_plane + size_t(chroma_w) * chroma_h;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const Uint32 pixel = slot.pixels[size_t(y) * width + x];
+            const int r = (pixel >> 16) & 0xFF, g = (pixel >> 8) & 0xFF, b = pixel & 0xFF;
+            y_plane[y * width + x] = Uint8(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            if (x % 2 == 0 && y % 2 == 0) {
+                u_plane[(y / 2) * chroma_w + x / 2] = Uint8(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                v_plane[(y / 2) * chroma_w + x / 2] = Uint8(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+    }
+    SDL_RWops *file = SDL_RWFromFile(path.c_str(), "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to save %s: %s", path.c_str(), SDL_GetError());
+        return;
+    }
+    SDL_RWwrite(file, yuv.data(), 1, yuv.size());
+    SDL_RWclose(file);
+}
@@ -0,0 +1,108 @@
+#ifndef CONTRA_FRAME_CAPTURE_H
+#define CONTRA_FRAME_CAPTURE_H
+
+#include <SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Saves the presented frames to disk without making the game wait for it.
+ *
+ * The render backend copies each frame into the next buffer of a ring preallocated at creation, and a
+ * pool of worker threads encodes the filled buffers to <folder>/frame_<frame>.png (or .yuv, raw I420).
+ * When the encoders fall behind and the next buffer is still in use, the frame is dropped and counted
+ * instead of blocking the render thread.
+ */
+class FrameCapture {
+public:
+    enum Format {
+        PNG,
+        YUV
+    };
+
+    // Allocates the buffers and starts the encoders, the capture starts disabled
+    void Create(int width, int height, const char *folder, Format format, int buffers = 8, int encoders = 2);
+
+    // Encodes the frames already captured and stops the encoders
+    void Destroy();
+
+    void SetEnabled(bool enabled);
+
+    void Toggle() {
+        SetEnabled(!IsEnabled());
+    }
+
+    [[nodiscard]] bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Called by the render thread once a frame is rendered
+     * @return The buffer where the ARGB8888 pixels of the frame must be copied, or nullptr if the capture
+     * is disabled or the frame has to be dropped
+     */
+    Uint32 *BeginFrame(Uint64 frame);
+
+    // Hands the buffer returned by BeginFrame to the encoders
+    void EndFrame();
+
+    [[nodiscard]] Uint64 GetCapturedFrames() const {
+        return captured.load();
+    }
+
+    [[nodiscard]] Uint64 GetDroppedFrames() const {
+        return dropped.load();
+    }
+
+    [[nodiscard]] int GetWidth() const {
+        return width;
+    }
+
+    [[nodiscard]] int GetHeight() const {
+        return height;
+    }
+
+private:
+    enum SlotState {
+        FREE,
+        FILLING, // Being written by the render thread
+        PENDING // Waiting for or being encoded
+    };
+
+    struct Slot {
+        std::vector<Uint32> pixels;
+        Uint64 frame = 0;
+        std::atomic<int> state{FREE};
+    };
+
+    void EncoderLoop();
+
+    // yuv is the conversion buffer of the calling encoder, only used for the YUV format
+    void Encode(const Slot &slot, std::vector<Uint8> &yuv) const;
+
+    int width = 0;
+    int height = 0;
+    std::string folder;
+    Format format = PNG;
+    std::atomic<bool> enabled{false};
+    std::atomic<Uint64> captured{0};
+    std::atomic<Uint64> dropped{0};
+
+    std::vector<Slot> slots;
+    int next = 0; // Next slot to fill, only used by the render thread
+
+    // Slots waiting to be encoded, in capture order
+    std::mutex pendingMutex;
+    std::condition_variable pendingCondition;
+    std::vector<int> pending;
+    int pendingStart = 0;
+    int pendingCount = 0;
+    bool running = false;
+    std::vector<std::thread> encoders;
+};
+
+#endif //CONTRA_FRAME_CAPTURE_H
@@ -0,0 +1,68 @@
+#include "frame_pacer.h"
+#include <algorithm>
+#include <thread>
+
+void FramePacer::Create(int target_fps, int history) {
+    frequency = SDL_GetPerformanceFrequency();
+    spinTicks = Uint64(SPIN_SECONDS * double(frequency));
+    frameTimes.assign(SDL_max(history, 1), 0.f);
+    next = 0;
+    count = 0;
+    SetTargetFps(target_fps);
+    last = SDL_GetPerformanceCounter();
+    deadline = last + period;
+}
+
+void FramePacer::SetTargetFps(int target_fps) {
+    targetFps = SDL_max(target_fps, 0);
+    period = targetFps > 0 ? frequency / Uint64(targetFps) : 0;
+    deadline = SDL_GetPerformanceCounter() + period;
+}
+
+float FramePacer::Wait() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (period > 0 && now < deadline) {
+        if (deadline - now > spinTicks) {
+            // Coarse sleep, waking up a bit early
+            auto sleep_ms = Uint32((deadline - now - spinTicks) * 1000 / frequency);
+            if (sleep_ms > 0)
+                SDL_Delay(sleep_ms);
+        }
+        now = SDL_GetPerformanceCounter();
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = SDL_GetPerformanceCounter();
+        }
+    }
+    if (period > 0) {
+        deadline += period;
+        // Too late for the next deadline (i.e. a long load), restart from now instead of rushing frames
+        if (deadline <= now)
+            deadline = now + period;
+    }
+
+    const float dt = float(double(now - last) / double(frequency));
+    last = now;
+    frameTimes[next] = dt;
+    next = (next + 1) % (int) frameTimes.size();
+    count = SDL_min(count + 1, (int) frameTimes.size());
+    return dt;
+}
+
+float FramePacer::GetPercentile(float percentile) const {
+    if (count == 0)
+        return 0.f;
+    sorted.assign(frameTimes.begin(), frameTimes.begin() + count);
+    auto index = size_t(SDL_max(0.f, SDL_min(percentile, 100.f)) / 100.f * float(count - 1) + 0.5f);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+float FramePacer::GetAverage() const {
+    if (count == 0)
+        return 0.f;
+    float total = 0.f;
+    for (int i = 0; i < count; i++)
+        total += frameTimes[i];
+    return total / float(count);
+}
@@ -0,0 +1,59 @@
+#ifndef CONTRA_FRAME_PACER_H
+#define CONTRA_FRAME_PACER_H
+
+#include <SDL.h>
+#include <vector>
+
+/**
+ * Keeps the main loop at a fixed frame rate using the high resolution performance counter.
+ * The wait for the next frame sleeps while there is time for it and spins, yielding, over the
+ * last part, where the scheduler wake up is not precise enough. The measured frame times are
+ * kept to get their percentiles.
+ */
+class FramePacer {
+public:
+    /**
+     * @param target_fps Frames per second to pace to, 0 to not wait at all (only measure)
+     * @param history Number of frame times kept for the stats
+     */
+    void Create(int target_fps, int history = 240);
+
+    void SetTargetFps(int target_fps);
+
+    [[nodiscard]] int GetTargetFps() const {
+        return targetFps;
+    }
+
+    /**
+     * Waits until the next frame is due
+     * @return Seconds elapsed since the previous call
+     */
+    float Wait();
+
+    /**
+     * Frame time, in seconds, below which the given percentage of the recent frames are
+     * @param percentile Between 0 and 100
+     */
+    [[nodiscard]] float GetPercentile(float percentile) const;
+
+    // Mean frame time of the recent frames, in seconds
+    [[nodiscard]] float GetAverage() const;
+
+private:
+    // Time before the deadline spent spinning instead of sleeping
+    static constexpr double SPIN_SECONDS = 0.002;
+
+    int targetFps = 0;
+    Uint64 frequency = 1;
+    Uint64 period = 0; // In counter ticks
+    Uint64 spinTicks = 0;
+    Uint64 deadline = 0;
+    Uint64 last = 0;
+
+    std::vector<float> frameTimes; // Ring buffer
+    int next = 0;
+    int count = 0;
+    mutable std::vector<float> sorted; // Scratch for the percentiles
+};
+
+#endif //CONTRA_FRAME_PACER_H
@@ -1,7 +1,8 @@
 #include "game_object.h"
 #include "component.h"
+#include "arena.h"
 
-int GameObject::s_nextId = 0;
+std::atomic<int> GameObject::s_nextId{0};
 
 void GameObject::Create() {
     enabled = false;
@@ -19,6 +20,12 @@ void GameObject::Init() {
     enabled = true;
 }
 
+void GameObject::Reset() {
+    activity = {};
+    for (auto it = components.begin(); it != components.end(); it++)
+        (*it)->Reset();
+}
+
 void GameObject::Update(float dt) {
     for (auto it = components.begin(); it != components.end(); it++) {
         if (!enabled || marked_to_remove)
@@ -37,6 +44,19 @@ GameObject::~GameObject() {
     if (!destroyed) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "GameObject(%d)::~GameObject but not destroyed", id);
     }
+    // The components belong to the object, nothing else frees them
+    for (auto it = components.begin(); it != components.end(); it++)
+        delete *it;
+}
+
+void *GameObject::operator new(size_t size) {
+    return Arena::Allocate(size, Arena::GAME_OBJECTS, [](void *game_object) {
+        static_cast<GameObject *>(game_object)->~GameObject();
+    });
+}
+
+void GameObject::operator delete(void *memory) {
+    Arena::Free(memory);
 }
 
 void GameObject::AddReceiver(GameObject *go) {
@@ -61,3 +81,8 @@ void GameObject::OnDisabled() {
     for (auto it = components.begin(); it != components.end(); it++)
         (*it)->OnGameObjectDisabled();
 }
+
+void GameObject::OnAsleep() {
+    for (auto it = components.begin(); it != components.end(); it++)
+        (*it)->OnGameObjectAsleep();
+}
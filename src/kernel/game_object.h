@@ -1,6 +1,7 @@
 #pragma once
 
 // GameObject represents objects which moves are drawn
+#include <atomic>
 #include <vector>
 #include <set>
 #include "vector2D.h"
@@ -30,7 +31,8 @@ public:
         DO_NOT_DESTROY
     };
 
-    static int s_nextId;
+    // Levels are constructed on a loading thread while the current scene keeps creating objects
+    static std::atomic<int> s_nextId;
     Vector2D position;
     /**
      * Determines whether the object should be destroyed or not on removal from the game objects
@@ -38,6 +40,20 @@ public:
      * eventually.
      */
     OnOutOfScreen onRemoval = DESTROY;
+    /** Slot of the object in the scene layer holding it, only used by SceneLayer */
+    int layerSlot = -1;
+    /**
+     * If set the scene stops updating the object when it is far from the camera and updates it less
+     * often near the edges of the screen (see SceneActivity). Not for objects checking the camera to
+     * remove themselves, i.e. bullets, as they would never do it.
+     */
+    bool sleepsOffScreen = false;
+    /** Activity of the object in the scene, only used by SceneActivity */
+    struct {
+        int tier = 0;
+        float skippedTime = 0.f; // Since its last update
+        float awakeTime = 0.f; // Kept awake wherever it is
+    } activity;
 
     GameObject() {
         id = s_nextId++;
@@ -46,16 +62,29 @@ public:
 
     virtual ~GameObject();
 
+    // Allocated in the current arena of the thread, if any (see Arena)
+    static void *operator new(size_t size);
+
+    static void operator delete(void *memory);
+
     virtual void Create();
 
     virtual void AddComponent(Component *component);
 
     virtual void Init();
 
+    /**
+     * Prepares an object taken again from a pool, resetting its components to how they were created.
+     * Init is called afterwards as for a new object.
+     */
+    virtual void Reset();
+
     virtual void Update(float dt);
 
     virtual void Destroy();
 
+    [[nodiscard]] bool IsDestroyed() const { return destroyed; }
+
     virtual void AddReceiver(GameObject *go);
 
     virtual void Receive(Message m) {}
@@ -64,6 +93,8 @@ public:
     void OnEnabled();
     /** Hoookup called when the GameObject is disabled */
     void OnDisabled();
+    /** Hookup called when the scene puts the GameObject to sleep, it is not updated until it wakes up */
+    void OnAsleep();
 
     /**
      * Marks the object to be removed at the end of the frame
@@ -0,0 +1,88 @@
+#include "glyph_atlas.h"
+#include "render_thread.h"
+
+bool GlyphAtlas::Create(TTF_Font *font) {
+    m_lineHeight = TTF_FontHeight(font);
+
+    const int glyph_count = LAST_GLYPH - FIRST_GLYPH + 1;
+    SDL_Surface *glyph_surfaces[glyph_count];
+    int cell_w = 1, cell_h = m_lineHeight;
+    const SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i < glyph_count; i++) {
+        // Rendering one char strings (instead of TTF_RenderGlyph_Solid) keeps the same vertical
+        // placement TTF_RenderText_Solid gives to whole lines
+        char str[2] = {char(FIRST_GLYPH + i), '\0'};
+        glyph_surfaces[i] = TTF_RenderText_Solid(font, str, white);
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, FIRST_GLYPH + i, nullptr, nullptr, nullptr, nullptr, &advance) < 0
+            && glyph_surfaces[i]) {
+            advance = glyph_surfaces[i]->w;
+        }
+        m_glyphs[i].advance = advance;
+        if (glyph_surfaces[i]) {
+            cell_w = SDL_max(cell_w, glyph_surfaces[i]->w);
+            cell_h = SDL_max(cell_h, glyph_surfaces[i]->h);
+        }
+    }
+
+    const int rows = (glyph_count + GLYPHS_PER_ROW - 1) / GLYPHS_PER_ROW;
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, cell_w * GLYPHS_PER_ROW, cell_h * rows, 32,
+                                                        SDL_PIXELFORMAT_RGBA32);
+    if (atlas == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Glyph atlas could not be created! SDL Error: %s\n",
+                     SDL_GetError());
+        for (auto *surface : glyph_surfaces)
+            SDL_FreeSurface(surface);
+        return false;
+    }
+    SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 0, 0, 0, 0));
+
+    for (int i = 0; i < glyph_count; i++) {
+        SDL_Rect &src = m_glyphs[i].src;
+        src.x = (i % GLYPHS_PER_ROW) * cell_w;
+        src.y = (i / GLYPHS_PER_ROW) * cell_h;
+        src.w = glyph_surfaces[i] ? glyph_surfaces[i]->w : 0;
+        src.h = glyph_surfaces[i] ? glyph_surfaces[i]->h : 0;
+        if (glyph_surfaces[i]) {
+            // Solid glyphs are palettized with a colour key, so only the glyph pixels are copied
+            SDL_BlitSurface(glyph_surfaces[i], nullptr, atlas, &src);
+            SDL_FreeSurface(glyph_surfaces[i]);
+        }
+    }
+
+    // Uploaded by the render backend the first time some text is drawn
+    m_texture = new Texture(atlas);
+    return true;
+}
+
+void GlyphAtlas::Destroy(RenderThread &render_thread) {
+    if (m_texture)
+        render_thread.Retire(m_texture);
+    m_texture = nullptr;
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::GetGlyph(char c) const {
+    if (c < FIRST_GLYPH || c > LAST_GLYPH)
+        c = '?';
+    return m_glyphs[c - FIRST_GLYPH];
+}
+
+int GlyphAtlas::MeasureWidth(const char *msg) const {
+    int width = 0;
+    for (const char *c = msg; *c; c++)
+        width += GetGlyph(*c).advance;
+    return width;
+}
+
+void GlyphAtlas::Draw(DrawList &list, int x, int y, const char *msg, SDL_Color color) const {
+    if (!m_texture)
+        return;
+    for (const char *c = msg; *c; c++) {
+        const Glyph &glyph = GetGlyph(*c);
+        if (glyph.src.w > 0) {
+            SDL_Rect dst_rect = {x, y, glyph.src.w, glyph.src.h};
+            list.AddTexture(m_texture, glyph.src, dst_rect, false, color);
+        }
+        x += glyph.advance;
+    }
+}
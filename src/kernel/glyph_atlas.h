@@ -0,0 +1,58 @@
+#ifndef CONTRA_GLYPH_ATLAS_H
+#define CONTRA_GLYPH_ATLAS_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include "draw_list.h"
+
+class RenderThread;
+
+/**
+ * Printable ASCII glyphs of a font rasterized once into a single white texture.
+ * Text is drawn as one textured quad per glyph, tinted with the texture colour mod,
+ * so consecutive glyphs end up in the same SDL render batch and no rasterization or
+ * texture upload happens while drawing.
+ */
+class GlyphAtlas {
+public:
+    static const int FIRST_GLYPH = 32; // ' '
+    static const int LAST_GLYPH = 126; // '~'
+    static const int GLYPHS_PER_ROW = 16;
+
+    struct Glyph {
+        SDL_Rect src; // Position of the glyph cell in the atlas
+        int advance; // Horizontal distance to the next glyph
+    };
+
+    /**
+     * Rasterizes the glyphs of the font in a single texture
+     * @return True on success
+     */
+    bool Create(TTF_Font *font);
+
+    // Hands the texture to the render thread to be released
+    void Destroy(RenderThread &render_thread);
+
+    /**
+     * @return The width of the text when drawn, computed from the cached advances
+     */
+    [[nodiscard]] int MeasureWidth(const char *msg) const;
+
+    [[nodiscard]] int GetLineHeight() const {
+        return m_lineHeight;
+    }
+
+    /**
+     * Adds the glyph quads of the text, with its top left corner at the given position, to the list
+     */
+    void Draw(DrawList &list, int x, int y, const char *msg, SDL_Color color) const;
+
+private:
+    [[nodiscard]] const Glyph &GetGlyph(char c) const;
+
+    Texture *m_texture = nullptr;
+    Glyph m_glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    int m_lineHeight = 0;
+};
+
+#endif //CONTRA_GLYPH_ATLAS_H
@@ -0,0 +1,174 @@
+#include "job_system.h"
+#include <SDL_log.h>
+
+thread_local int JobSystem::s_workerIndex = -1;
+
+void JobSystem::Start(int num_workers) {
+    m_running = true;
+    for (int i = 0; i < num_workers; i++)
+        m_workers.push_back(std::make_unique<Worker>());
+    // Once all the deques exist, as the workers steal from each other
+    for (int i = 0; i < num_workers; i++) {
+        m_workers[i]->thread = std::thread([this, i]() {
+            s_workerIndex = i;
+            Loop(i);
+        });
+    }
+    SDL_Log("JobSystem::Start: %d workers%s", num_workers, num_workers == 0 ? " (serial)" : "");
+}
+
+void JobSystem::Stop() {
+    if (!m_running.load())
+        return;
+    // Runs the jobs left before stopping the workers
+    while (TryRunOne()) {}
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (auto &worker : m_workers)
+        worker->thread.join();
+    m_workers.clear();
+    RunMainThreadJobs();
+}
+
+int JobSystem::DefaultWorkers() {
+    int cores = int(std::thread::hardware_concurrency());
+    return cores > 1 ? cores - 1 : 1;
+}
+
+void JobSystem::Run(Job job, JobCounter *counter) {
+    if (counter)
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    Push({std::move(job), counter});
+}
+
+void JobSystem::RunAfter(JobCounter &dependency, Job job, JobCounter *counter) {
+    if (counter)
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        // Finish takes the continuations under the same lock when the counter gets to 0
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.IsDone()) {
+            dependency.m_continuations.emplace_back(std::move(job), counter);
+            return;
+        }
+    }
+    Push({std::move(job), counter});
+}
+
+void JobSystem::Wait(JobCounter &counter) {
+    while (!counter.IsDone()) {
+        if (!TryRunOne())
+            std::this_thread::yield(); // The last ones are running on other workers
+    }
+    // Until the last job has released the counter
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::RunOnMainThread(Job job) {
+    std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+    m_mainThreadJobs.push_back(std::move(job));
+}
+
+void JobSystem::RunMainThreadJobs() {
+    std::vector<Job> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        jobs.swap(m_mainThreadJobs);
+    }
+    // The ones queued meanwhile are run next time
+    for (auto &job : jobs)
+        job();
+}
+
+void JobSystem::Push(Task task) {
+    if (m_workers.empty()) {
+        Execute(task);
+        return;
+    }
+    int index = s_workerIndex >= 0 ? s_workerIndex : int(m_nextWorker++ % m_workers.size());
+    {
+        std::lock_guard<std::mutex> lock(m_workers[index]->mutex);
+        m_workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Under the lock, so a worker about to sleep does not miss it
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queued++;
+    }
+    m_wake.notify_one();
+}
+
+void JobSystem::Execute(Task &task) {
+    task.job();
+    if (task.counter)
+        Finish(task.counter);
+}
+
+void JobSystem::Finish(JobCounter *counter) {
+    std::vector<std::pair<Job, JobCounter *>> continuations;
+    {
+        // The counter is not touched once unlocked, whoever waits for it can destroy it then
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        continuations.swap(counter->m_continuations);
+    }
+    // Already counted by RunAfter
+    for (auto &continuation : continuations)
+        Push({std::move(continuation.first), continuation.second});
+}
+
+bool JobSystem::TryTake(int worker_index, Task &task) {
+    if (worker_index >= 0) {
+        Worker &own = *m_workers[worker_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_queued--;
+            return true;
+        }
+    }
+    int count = int(m_workers.size());
+    int start = worker_index >= 0 ? worker_index + 1 : 0;
+    for (int i = 0; i < count; i++) {
+        Worker &victim = *m_workers[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            // The oldest, usually the biggest piece of work left
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::TryRunOne() {
+    Task task;
+    if (m_workers.empty() || !TryTake(s_workerIndex, task))
+        return false;
+    Execute(task);
+    return true;
+}
+
+void JobSystem::Loop(int worker_index) {
+    Task task;
+    while (true) {
+        if (TryTake(worker_index, task)) {
+            Execute(task);
+            task.job = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() {
+            return m_queued.load() > 0 || !m_running.load();
+        });
+        if (!m_running.load() && m_queued.load() == 0)
+            break;
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef CONTRA_JOB_SYSTEM_H
+#define CONTRA_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef std::function<void()> Job;
+
+/**
+ * Counts the jobs of a group which have not finished yet, to wait for them or to run other jobs once
+ * they are done. It must outlive the jobs counted and the ones waiting for it.
+ */
+class JobCounter {
+public:
+    [[nodiscard]] bool IsDone() const {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<int> m_pending{0};
+    std::mutex m_mutex;
+    // Jobs to run once the counter reaches 0, with the counters they belong to
+    std::vector<std::pair<Job, JobCounter *>> m_continuations;
+};
+
+/**
+ * Runs jobs on a set of worker threads.
+ *
+ * Each worker has its own deque: it takes the jobs it queues from the back (the latest, still in cache)
+ * and, when it runs out, steals from the front of the other deques. Jobs queued from other threads are
+ * spread over the deques. Waiting for a counter runs queued jobs meanwhile instead of blocking, so jobs
+ * can wait for the jobs they start.
+ *
+ * Jobs can not call SDL (rendering, audio, windows), RunOnMainThread queues what has to be done there.
+ *
+ * With 0 workers it runs in serial mode: every job runs on the calling thread as soon as it is run,
+ * in the same order every time, which keeps the headless runs and their frame hashes deterministic.
+ */
+class JobSystem {
+public:
+    ~JobSystem() {
+        Stop();
+    }
+
+    /**
+     * @param num_workers Worker threads, 0 for the serial mode
+     */
+    void Start(int num_workers);
+
+    // Waits for the queued jobs and stops the workers, the main thread jobs are run too. Nothing if not started.
+    void Stop();
+
+    // One worker per core, the main thread keeps the other one
+    static int DefaultWorkers();
+
+    [[nodiscard]] int GetWorkerCount() const {
+        return int(m_workers.size());
+    }
+
+    [[nodiscard]] bool IsSerial() const {
+        return m_workers.empty();
+    }
+
+    /**
+     * Queues the job, it can run on any worker
+     * @param counter Counted until the job finishes, can be nullptr
+     */
+    void Run(Job job, JobCounter *counter = nullptr);
+
+    /**
+     * Queues the job once all the jobs of the dependency have finished, at once if they already have
+     * @param counter Counted until the job finishes, from now on so waiting for it covers the dependency
+     */
+    void RunAfter(JobCounter &dependency, Job job, JobCounter *counter = nullptr);
+
+    /** Runs queued jobs until all the jobs of the counter have finished */
+    void Wait(JobCounter &counter);
+
+    /**
+     * Calls function(begin, end) for consecutive ranges of at most batch_size indices covering [0, count),
+     * in parallel, and returns once all of them are done
+     */
+    template<class Function>
+    void ParallelFor(int count, int batch_size, const Function &function) {
+        if (batch_size < 1)
+            batch_size = 1;
+        JobCounter counter;
+        for (int begin = 0; begin < count; begin += batch_size) {
+            int end = begin + batch_size < count ? begin + batch_size : count;
+            Run([&function, begin, end]() {
+                function(begin, end);
+            }, &counter);
+        }
+        Wait(counter);
+    }
+
+    /** Queues the job to be run by the main thread on its next RunMainThreadJobs, can be called from any thread */
+    void RunOnMainThread(Job job);
+
+    /** Runs the jobs queued for the main thread, in the order they were queued. Main thread only. */
+    void RunMainThreadJobs();
+
+private:
+    struct Task {
+        Job job;
+        JobCounter *counter;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void Push(Task task);
+
+    void Execute(Task &task);
+
+    void Finish(JobCounter *counter);
+
+    // Takes a task of the deque of the worker or steals one from the others, index -1 for other threads
+    bool TryTake(int worker_index, Task &task);
+
+    // Runs one queued task if there is any
+    bool TryRunOne();
+
+    void Loop(int worker_index);
+
+    // Index of the worker running in the thread, -1 for other threads
+    static thread_local int s_workerIndex;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<unsigned int> m_nextWorker{0};
+    std::atomic<int> m_queued{0};
+    std::atomic<bool> m_running{false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    std::mutex m_mainThreadMutex;
+    std::vector<Job> m_mainThreadJobs;
+};
+
+#endif //CONTRA_JOB_SYSTEM_H
@@ -29,6 +29,7 @@ public:
 	{
 		for (auto it = pool.begin(); it != pool.end(); it++)
 			delete *it;
+		pool.clear();
 	}
 
 	~ObjectPool()
@@ -61,6 +62,16 @@ public:
         return available;
     }
 
+	// Number of objects of the pool in use
+	unsigned int CountEnabled() const
+	{
+		unsigned int count = 0;
+		for (auto it = pool.begin(); it != pool.end(); it++)
+			if ((**it).IsEnabled())
+				count++;
+		return count;
+	}
+
 	// select a random, enabled element in the object pool
 	T* SelectRandom()
 	{
@@ -0,0 +1,69 @@
+#ifndef CONTRA_PREFAB_POOL_H
+#define CONTRA_PREFAB_POOL_H
+
+#include <functional>
+#include "object_pool.h"
+
+/**
+ * Pool of game objects all built the same way, for the short lived entities spawned during the game.
+ * The objects are built up front and handed again once they are disabled, after GameObject::Reset, so
+ * spawning them does not allocate once the pool is warm. If all of them are in use one more is built.
+ *
+ * The objects never destroy on removal from the scene, the pool destroys and frees them with their
+ * components when it is destroyed, once the scene does not hold them any more.
+ */
+template<class T>
+class PrefabPool {
+public:
+    /**
+     * @param build Creates a new object, setting up everything that does not change between uses
+     */
+    void Create(unsigned int num_objects, std::function<void(T *)> build) {
+        m_build = std::move(build);
+        m_objects.Create(num_objects);
+        for (auto *object : m_objects.pool)
+            Build(object);
+    }
+
+    /**
+     * @return An object ready to be initialized and added to the scene
+     */
+    T *Acquire() {
+        T *object = m_objects.FirstAvailable();
+        if (object == nullptr) {
+            object = new T();
+            Build(object);
+            m_objects.pool.push_back(object);
+        } else {
+            object->Reset();
+        }
+        return object;
+    }
+
+    void Destroy() {
+        for (auto *object : m_objects.pool)
+            if (!object->IsDestroyed())
+                object->Destroy();
+        m_objects.Deallocate();
+    }
+
+    // Number of objects of the pool in use
+    [[nodiscard]] unsigned int CountEnabled() const {
+        return m_objects.CountEnabled();
+    }
+
+    [[nodiscard]] size_t Size() const {
+        return m_objects.pool.size();
+    }
+
+private:
+    void Build(T *object) {
+        m_build(object);
+        object->onRemoval = GameObject::DO_NOT_DESTROY;
+    }
+
+    ObjectPool<T> m_objects;
+    std::function<void(T *)> m_build;
+};
+
+#endif //CONTRA_PREFAB_POOL_H
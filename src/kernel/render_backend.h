@@ -0,0 +1,35 @@
+#ifndef CONTRA_RENDER_BACKEND_H
+#define CONTRA_RENDER_BACKEND_H
+
+#include "draw_list.h"
+#include "frame_capture.h"
+
+/**
+ * Executes the draw lists produced by the simulation. All the methods are called from the
+ * thread rendering the frames, which may not be the main thread.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // Creates the rendering resources. Returns true on success.
+    virtual bool Create() = 0;
+
+    // Draws the list in a cleared frame and presents it
+    virtual void Render(const DrawList &list) = 0;
+
+    // Frees the backend resources of the texture, the Texture itself is deleted by the caller
+    virtual void ReleaseTexture(Texture *texture) = 0;
+
+    virtual void Destroy() = 0;
+
+    // The frames rendered afterwards are copied to the capture when it is enabled
+    void SetCapture(FrameCapture *frame_capture) {
+        capture = frame_capture;
+    }
+
+protected:
+    FrameCapture *capture = nullptr;
+};
+
+#endif //CONTRA_RENDER_BACKEND_H
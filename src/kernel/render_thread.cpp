@@ -0,0 +1,91 @@
+#include "render_thread.h"
+#include <algorithm>
+#include <future>
+
+bool RenderThread::Start(RenderBackend *backend, bool threaded) {
+    m_backend = backend;
+    m_threaded = threaded;
+    if (!threaded)
+        return m_backend->Create();
+
+    // The renderer has to be created by the thread using it
+    std::promise<bool> created;
+    std::future<bool> result = created.get_future();
+    m_frameReady = SDL_CreateSemaphore(0);
+    m_running = true;
+    m_thread = std::thread([this, &created]() {
+        bool ok = m_backend->Create();
+        created.set_value(ok);
+        if (ok)
+            Loop();
+    });
+    if (!result.get()) {
+        m_running = false;
+        m_thread.join();
+        return false;
+    }
+    return true;
+}
+
+void RenderThread::Loop() {
+    while (true) {
+        SDL_SemWait(m_frameReady);
+        if (!m_running.load(std::memory_order_acquire))
+            break;
+        if (!(m_middle.load(std::memory_order_acquire) & NEW_FRAME))
+            continue;
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        const DrawList &list = m_lists[m_front];
+        m_backend->Render(list);
+        ReleaseRetired(list.frame);
+    }
+}
+
+void RenderThread::Submit() {
+    DrawList &list = m_lists[m_back];
+    list.frame = m_frame.fetch_add(1);
+    if (m_threaded) {
+        m_back = m_middle.exchange(m_back | NEW_FRAME, std::memory_order_acq_rel) & INDEX_MASK;
+        SDL_SemPost(m_frameReady);
+    } else {
+        m_backend->Render(list);
+        ReleaseRetired(list.frame);
+    }
+    m_lists[m_back].Clear();
+}
+
+void RenderThread::Retire(Texture *texture) {
+    std::lock_guard<std::mutex> lock(m_retiredMutex);
+    m_retired.emplace_back(m_frame.load(), texture);
+}
+
+void RenderThread::ReleaseRetired(Uint64 frame) {
+    std::lock_guard<std::mutex> lock(m_retiredMutex);
+    auto released = std::stable_partition(m_retired.begin(), m_retired.end(),
+                                          [frame](const std::pair<Uint64, Texture *> &retired) {
+                                              return retired.first > frame;
+                                          });
+    for (auto it = released; it != m_retired.end(); it++) {
+        m_backend->ReleaseTexture(it->second);
+        if (it->second->surface)
+            SDL_FreeSurface(it->second->surface);
+        delete it->second;
+    }
+    m_retired.erase(released, m_retired.end());
+}
+
+void RenderThread::Stop() {
+    if (m_backend == nullptr)
+        return;
+    if (m_threaded) {
+        m_running.store(false, std::memory_order_release);
+        SDL_SemPost(m_frameReady);
+        m_thread.join();
+        SDL_DestroySemaphore(m_frameReady);
+        m_frameReady = nullptr;
+    }
+    // No frame is pending anymore, the textures are released from this thread
+    ReleaseRetired(ALL_FRAMES);
+    m_backend->Destroy();
+    m_backend = nullptr;
+}
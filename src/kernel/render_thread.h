@@ -0,0 +1,79 @@
+#ifndef CONTRA_RENDER_THREAD_H
+#define CONTRA_RENDER_THREAD_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "render_backend.h"
+
+/**
+ * Hands the draw lists recorded by the simulation to the thread owning the render backend.
+ *
+ * The lists live in a lock-free triple buffer: the simulation records in the back list and publishes
+ * it by swapping it with the middle one, the render thread takes the middle one when a new frame
+ * has been published. The simulation never waits for the GPU, it can be a frame ahead of what is
+ * being presented and if it gets further ahead the older unrendered frame is just skipped.
+ *
+ * In serial mode there is no thread and the lists are rendered when submitted, on the calling thread.
+ */
+class RenderThread {
+public:
+    /**
+     * Creates the backend, on the render thread if threaded.
+     * @return True if the backend could be created
+     */
+    bool Start(RenderBackend *backend, bool threaded);
+
+    // Stops the thread, releases the retired textures and destroys the backend
+    void Stop();
+
+    /**
+     * @return The list where the current frame is recorded, only used by the simulation thread
+     */
+    DrawList &GetBackList() {
+        return m_lists[m_back];
+    }
+
+    /**
+     * Publishes the back list to be rendered and starts recording the next frame in an empty one
+     */
+    void Submit();
+
+    /**
+     * Queues the texture to be released by the backend and deleted once no frame which could
+     * draw it is pending. Can be called from any thread.
+     */
+    void Retire(Texture *texture);
+
+    [[nodiscard]] bool IsThreaded() const {
+        return m_threaded;
+    }
+
+private:
+    static const int NEW_FRAME = 4; // Set on m_middle when it holds a frame not rendered yet
+    static const int INDEX_MASK = 3;
+    static const Uint64 ALL_FRAMES = ~Uint64(0);
+
+    void Loop();
+
+    // Releases the textures retired while recording the given frame or before
+    void ReleaseRetired(Uint64 frame);
+
+    RenderBackend *m_backend = nullptr;
+    bool m_threaded = false;
+    std::thread m_thread;
+    SDL_sem *m_frameReady = nullptr;
+    std::atomic<bool> m_running{false};
+
+    DrawList m_lists[3];
+    int m_back = 0; // Only touched by the simulation
+    int m_front = 1; // Only touched by the render thread
+    std::atomic<int> m_middle{2};
+    std::atomic<Uint64> m_frame{1};
+
+    std::mutex m_retiredMutex;
+    std::vector<std::pair<Uint64, Texture *>> m_retired;
+};
+
+#endif //CONTRA_RENDER_THREAD_H
@@ -0,0 +1,109 @@
+#include "sdl_render_backend.h"
+
+bool SDLRenderBackend::Create() {
+    //Create renderer for window
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+    if (renderer == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Renderer could not be created! SDL Error: %s\n", SDL_GetError());
+        return false;
+    }
+
+    // The fills take the alpha of their color into account, as the software backend does
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    // Pixel art, the upscale has to keep the pixels sharp
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+    frameTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                    nativeWidth, nativeHeight);
+    if (frameTarget == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame target could not be created! SDL Error: %s\n",
+                     SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+SDL_Texture *SDLRenderBackend::Upload(Texture *texture) {
+    if (texture->texture == nullptr && texture->surface != nullptr) {
+        texture->texture = SDL_CreateTextureFromSurface(renderer, texture->surface);
+        if (texture->texture == nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create texture! SDL Error: %s\n", SDL_GetError());
+        }
+        SDL_FreeSurface(texture->surface);
+        texture->surface = nullptr;
+    }
+    return texture->texture;
+}
+
+void SDLRenderBackend::Render(const DrawList &list) {
+    SDL_SetRenderTarget(renderer, frameTarget);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 255);
+    SDL_RenderClear(renderer);
+
+    for (Texture *texture : list.uploads)
+        Upload(texture);
+
+    for (const DrawCommand &command : list.commands) {
+        switch (command.type) {
+            case DrawCommand::TEXTURE: {
+                SDL_Texture *texture = Upload(command.texture);
+                if (texture == nullptr)
+                    break;
+                SDL_SetTextureColorMod(texture, command.color.r, command.color.g, command.color.b);
+                if (command.mirrorHorizontal)
+                    SDL_RenderCopyEx(renderer, texture, &command.src, &command.dst, 0, nullptr, SDL_FLIP_HORIZONTAL);
+                else
+                    SDL_RenderCopy(renderer, texture, &command.src, &command.dst);
+                break;
+            }
+            case DrawCommand::FILL_RECT:
+                SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+                SDL_RenderFillRect(renderer, &command.dst);
+                break;
+            case DrawCommand::STROKE_RECT:
+                SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+                SDL_RenderDrawRect(renderer, &command.dst);
+                break;
+            case DrawCommand::FILL_RECTS:
+                SDL_SetRenderDrawColor(renderer, command.color.r, command.color.g, command.color.b, command.color.a);
+                SDL_RenderFillRects(renderer, list.rects.data() + command.src.x, command.src.w);
+                break;
+        }
+    }
+
+    if (capture) {
+        // Read back at native resolution, this only stalls the render thread
+        if (Uint32 *pixels = capture->BeginFrame(list.frame)) {
+            SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels, nativeWidth * 4);
+            capture->EndFrame();
+        }
+    }
+
+    // Single upscale of the whole frame, letterboxed to the biggest integer scale fitting the window
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 255);
+    SDL_RenderClear(renderer);
+    int output_w, output_h;
+    SDL_GetRendererOutputSize(renderer, &output_w, &output_h);
+    int scale = SDL_max(1, SDL_min(output_w / nativeWidth, output_h / nativeHeight));
+    SDL_Rect dst = {(output_w - nativeWidth * scale) / 2, (output_h - nativeHeight * scale) / 2,
+                    nativeWidth * scale, nativeHeight * scale};
+    SDL_RenderCopy(renderer, frameTarget, nullptr, &dst);
+
+    //Update screen
+    SDL_RenderPresent(renderer);
+}
+
+void SDLRenderBackend::ReleaseTexture(Texture *texture) {
+    if (texture->texture)
+        SDL_DestroyTexture(texture->texture);
+    texture->texture = nullptr;
+}
+
+void SDLRenderBackend::Destroy() {
+    if (frameTarget)
+        SDL_DestroyTexture(frameTarget);
+    if (renderer)
+        SDL_DestroyRenderer(renderer);
+    frameTarget = nullptr;
+    renderer = nullptr;
+}
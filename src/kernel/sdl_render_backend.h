@@ -0,0 +1,34 @@
+#ifndef CONTRA_SDL_RENDER_BACKEND_H
+#define CONTRA_SDL_RENDER_BACKEND_H
+
+#include "render_backend.h"
+
+/**
+ * Renders the frame at native resolution in a target texture with SDL_Renderer and copies it to the
+ * window with the biggest integer scale that fits, letterboxed.
+ */
+class SDLRenderBackend : public RenderBackend {
+public:
+    SDLRenderBackend(SDL_Window *window, int native_width, int native_height)
+            : window(window), nativeWidth(native_width), nativeHeight(native_height) {}
+
+    bool Create() override;
+
+    void Render(const DrawList &list) override;
+
+    void ReleaseTexture(Texture *texture) override;
+
+    void Destroy() override;
+
+private:
+    // Creates the SDL_Texture the first time the texture is drawn
+    SDL_Texture *Upload(Texture *texture);
+
+    SDL_Window *window;
+    SDL_Renderer *renderer = nullptr;
+    SDL_Texture *frameTarget = nullptr;
+    int nativeWidth;
+    int nativeHeight;
+};
+
+#endif //CONTRA_SDL_RENDER_BACKEND_H
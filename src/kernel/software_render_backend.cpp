@@ -0,0 +1,214 @@
+#include "software_render_backend.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static inline Uint32 blendPixel(Uint32 dst, Uint32 src) {
+    const Uint32 alpha = src >> 24;
+    if (alpha == 255)
+        return src;
+    if (alpha == 0)
+        return dst;
+    const Uint32 rb = (((src & 0xFF00FF) * alpha + (dst & 0xFF00FF) * (255 - alpha)) >> 8) & 0xFF00FF;
+    const Uint32 g = (((src & 0x00FF00) * alpha + (dst & 0x00FF00) * (255 - alpha)) >> 8) & 0x00FF00;
+    return 0xFF000000 | rb | g;
+}
+
+static inline Uint32 tintPixel(Uint32 pixel, SDL_Color tint) {
+    const Uint32 r = ((pixel >> 16) & 0xFF) * tint.r / 255;
+    const Uint32 g = ((pixel >> 8) & 0xFF) * tint.g / 255;
+    const Uint32 b = (pixel & 0xFF) * tint.b / 255;
+    return (pixel & 0xFF000000) | (r << 16) | (g << 8) | b;
+}
+
+/**
+ * Blits count pixels from the source row starting at sx (going left if mirrored) to dst
+ */
+static void blitSpan(Uint32 *dst, const Uint32 *src_row, int sx, int count, bool mirror) {
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i alpha_mask = _mm_set1_epi32(int(0xFF000000));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i src;
+        if (mirror) {
+            src = _mm_loadu_si128((const __m128i *) (src_row + sx - i - 3));
+            src = _mm_shuffle_epi32(src, _MM_SHUFFLE(0, 1, 2, 3));
+        } else {
+            src = _mm_loadu_si128((const __m128i *) (src_row + sx + i));
+        }
+        const __m128i alpha = _mm_and_si128(src, alpha_mask);
+        const __m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+        const __m128i opaque = _mm_cmpeq_epi32(alpha, alpha_mask);
+        if (_mm_movemask_epi8(_mm_or_si128(transparent, opaque)) != 0xFFFF) {
+            // Some translucent pixel, rare in pixel art
+            for (int k = i; k < i + 4; k++)
+                dst[k] = blendPixel(dst[k], mirror ? src_row[sx - k] : src_row[sx + k]);
+            continue;
+        }
+        const __m128i old = _mm_loadu_si128((const __m128i *) (dst + i));
+        const __m128i result = _mm_or_si128(_mm_and_si128(transparent, old), _mm_andnot_si128(transparent, src));
+        _mm_storeu_si128((__m128i *) (dst + i), result);
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = blendPixel(dst[i], mirror ? src_row[sx - i] : src_row[sx + i]);
+}
+
+SoftwareRenderBackend::SoftwareRenderBackend(int width, int height, const char *hash_log_path,
+                                             const char *dump_folder)
+        : width(width), height(height), hashLogPath(hash_log_path ? hash_log_path : ""),
+          dumpFolder(dump_folder ? dump_folder : "") {}
+
+bool SoftwareRenderBackend::Create() {
+    framebuffer.assign(size_t(width) * height, 0xFF000000);
+    if (!hashLogPath.empty()) {
+        hashLog = fopen(hashLogPath.c_str(), "w");
+        if (hashLog == nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame hash log %s could not be opened", hashLogPath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+SDL_Surface *SoftwareRenderBackend::Prepare(Texture *texture) {
+    SDL_Surface *surface = texture->surface;
+    if (surface != nullptr && surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        texture->surface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(surface);
+        surface = texture->surface;
+    }
+    return surface;
+}
+
+void SoftwareRenderBackend::Render(const DrawList &list) {
+    std::fill(framebuffer.begin(), framebuffer.end(), 0xFF000000);
+
+    for (Texture *texture : list.uploads)
+        Prepare(texture);
+
+    for (const DrawCommand &command : list.commands) {
+        switch (command.type) {
+            case DrawCommand::TEXTURE:
+                Blit(command);
+                break;
+            case DrawCommand::FILL_RECT:
+                Fill(command.dst, command.color);
+                break;
+            case DrawCommand::STROKE_RECT:
+                Stroke(command.dst, command.color);
+                break;
+            case DrawCommand::FILL_RECTS:
+                for (int i = command.src.x; i < command.src.x + command.src.w; i++)
+                    Fill(list.rects[i], command.color);
+                break;
+        }
+    }
+
+    if (capture) {
+        if (Uint32 *pixels = capture->BeginFrame(list.frame)) {
+            memcpy(pixels, framebuffer.data(), framebuffer.size() * sizeof(Uint32));
+            capture->EndFrame();
+        }
+    }
+    if (hashLog) {
+        fprintf(hashLog, "%llu %016llx\n", (unsigned long long) list.frame, (unsigned long long) GetFrameHash());
+    }
+    if (!dumpFolder.empty()) {
+        SDL_Surface *frame = SDL_CreateRGBSurfaceWithFormatFrom(framebuffer.data(), width, height, 32, width * 4,
+                                                                SDL_PIXELFORMAT_ARGB8888);
+        char path[32];
+        snprintf(path, sizeof(path), "/frame_%06llu.bmp", (unsigned long long) list.frame);
+        SDL_SaveBMP(frame, (dumpFolder + path).c_str());
+        SDL_FreeSurface(frame);
+    }
+}
+
+void SoftwareRenderBackend::Blit(const DrawCommand &command) {
+    SDL_Surface *surface = Prepare(command.texture);
+    const SDL_Rect &src = command.src;
+    const SDL_Rect &dst = command.dst;
+    if (surface == nullptr || src.w <= 0 || src.h <= 0 || dst.w <= 0 || dst.h <= 0)
+        return;
+
+    const int x0 = std::max(0, dst.x), x1 = std::min(width, dst.x + dst.w);
+    const int y0 = std::max(0, dst.y), y1 = std::min(height, dst.y + dst.h);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    const SDL_Color tint = command.color;
+    const bool tinted = tint.r != 255 || tint.g != 255 || tint.b != 255;
+    const bool unscaled = src.w == dst.w && src.h == dst.h;
+    const bool inside = src.x >= 0 && src.y >= 0 && src.x + src.w <= surface->w && src.y + src.h <= surface->h;
+    const bool mirror = command.mirrorHorizontal;
+
+    for (int y = y0; y < y1; y++) {
+        const int sy = src.y + int(Sint64(y - dst.y) * src.h / dst.h);
+        if (sy < 0 || sy >= surface->h)
+            continue;
+        const auto *src_row = (const Uint32 *) ((const Uint8 *) surface->pixels + sy * surface->pitch);
+        Uint32 *dst_row = framebuffer.data() + size_t(y) * width;
+
+        if (unscaled && inside && !tinted) {
+            const int offset = x0 - dst.x;
+            blitSpan(dst_row + x0, src_row, mirror ? src.x + src.w - 1 - offset : src.x + offset, x1 - x0, mirror);
+            continue;
+        }
+        for (int x = x0; x < x1; x++) {
+            int column = int(Sint64(x - dst.x) * src.w / dst.w);
+            const int sx = src.x + (mirror ? src.w - 1 - column : column);
+            if (sx < 0 || sx >= surface->w)
+                continue;
+            Uint32 pixel = src_row[sx];
+            if (tinted)
+                pixel = tintPixel(pixel, tint);
+            dst_row[x] = blendPixel(dst_row[x], pixel);
+        }
+    }
+}
+
+void SoftwareRenderBackend::Fill(const SDL_Rect &rect, SDL_Color color) {
+    const Uint32 pixel = (Uint32(color.a) << 24) | (color.r << 16) | (color.g << 8) | color.b;
+    const int x0 = std::max(0, rect.x), x1 = std::min(width, rect.x + rect.w);
+    if (x0 >= x1 || color.a == 0)
+        return;
+    for (int y = std::max(0, rect.y); y < std::min(height, rect.y + rect.h); y++) {
+        Uint32 *row = framebuffer.data() + size_t(y) * width;
+        if (color.a == 255) {
+            std::fill_n(row + x0, x1 - x0, pixel);
+            continue;
+        }
+        // Translucent, blended as the SDL backend does
+        for (int x = x0; x < x1; x++)
+            row[x] = blendPixel(row[x], pixel);
+    }
+}
+
+void SoftwareRenderBackend::Stroke(const SDL_Rect &rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0)
+        return;
+    Fill({rect.x, rect.y, rect.w, 1}, color);
+    Fill({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    Fill({rect.x, rect.y, 1, rect.h}, color);
+    Fill({rect.x + rect.w - 1, rect.y, 1, rect.h}, color);
+}
+
+Uint64 SoftwareRenderBackend::GetFrameHash() const {
+    Uint64 hash = 14695981039346656037ULL;
+    for (Uint32 pixel : framebuffer) {
+        hash ^= pixel;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void SoftwareRenderBackend::Destroy() {
+    if (hashLog)
+        fclose(hashLog);
+    hashLog = nullptr;
+    framebuffer.clear();
+}
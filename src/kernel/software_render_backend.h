@@ -0,0 +1,68 @@
+#ifndef CONTRA_SOFTWARE_RENDER_BACKEND_H
+#define CONTRA_SOFTWARE_RENDER_BACKEND_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "render_backend.h"
+
+/**
+ * Rasterizes the draw lists on the CPU into an ARGB8888 framebuffer, no window or GPU is needed.
+ * Used to run the game headless, checking what is drawn frame by frame: every frame can be hashed
+ * to a log and/or dumped as a BMP image.
+ *
+ * Textures are drawn with nearest sampling, pixels with alpha 0 are skipped (colour key), opaque ones
+ * copied and the rest blended. Unscaled, untinted spans (almost everything in the game) are blitted
+ * four pixels at a time with SSE2 when available.
+ */
+class SoftwareRenderBackend : public RenderBackend {
+public:
+    /**
+     * @param hash_log_path File where "<frame> <hash>" is written for every frame, or nullptr
+     * @param dump_folder Folder where every frame is saved as frame_<frame>.bmp, or nullptr
+     */
+    SoftwareRenderBackend(int width, int height, const char *hash_log_path = nullptr,
+                          const char *dump_folder = nullptr);
+
+    bool Create() override;
+
+    void Render(const DrawList &list) override;
+
+    void ReleaseTexture(Texture *texture) override {} // Only the surface is used, freed with the Texture
+
+    void Destroy() override;
+
+    [[nodiscard]] const Uint32 *GetPixels() const {
+        return framebuffer.data();
+    }
+
+    [[nodiscard]] int GetWidth() const {
+        return width;
+    }
+
+    [[nodiscard]] int GetHeight() const {
+        return height;
+    }
+
+    // FNV-1a hash of the pixels of the last rendered frame
+    [[nodiscard]] Uint64 GetFrameHash() const;
+
+private:
+    // Converts the surface of the texture to the framebuffer format the first time it is drawn
+    SDL_Surface *Prepare(Texture *texture);
+
+    void Blit(const DrawCommand &command);
+
+    void Fill(const SDL_Rect &rect, SDL_Color color);
+
+    void Stroke(const SDL_Rect &rect, SDL_Color color);
+
+    int width;
+    int height;
+    std::vector<Uint32> framebuffer;
+    std::string hashLogPath;
+    std::string dumpFolder;
+    FILE *hashLog = nullptr;
+};
+
+#endif //CONTRA_SOFTWARE_RENDER_BACKEND_H
@@ -0,0 +1,67 @@
+#include "tile_map.h"
+#include <cmath>
+#include <cstring>
+#include "avancezlib.h"
+
+TileMap::TileMap() = default;
+
+TileMap::~TileMap() = default;
+
+bool TileMap::Load(AvancezLib *engine, const char *map_path, const char *tileset_path) {
+    SDL_RWops *file = SDL_RWFromFile(map_path, "rb");
+    if (file == nullptr) {
+        SDL_Log("Tile map %s not found, %s", map_path, SDL_GetError());
+        return false;
+    }
+
+    char magic[4];
+    if (SDL_RWread(file, magic, 1, 4) != 4 || memcmp(magic, MAGIC, 4) != 0 || SDL_ReadLE16(file) != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tile map %s has an unsupported format", map_path);
+        SDL_RWclose(file);
+        return false;
+    }
+    m_tileSize = SDL_ReadLE16(file);
+    m_columns = SDL_ReadLE16(file);
+    m_rows = SDL_ReadLE16(file);
+    m_frames = SDL_ReadLE16(file);
+    m_tilesetColumns = SDL_ReadLE16(file);
+    m_width = SDL_ReadLE32(file);
+    m_height = SDL_ReadLE32(file);
+
+    m_tiles.resize(size_t(m_frames) * m_rows * m_columns);
+    size_t read = SDL_RWread(file, m_tiles.data(), sizeof(Uint16), m_tiles.size());
+    SDL_RWclose(file);
+    if (read != m_tiles.size() || m_tileSize == 0 || m_frames == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tile map %s is truncated", map_path);
+        m_tiles.clear();
+        return false;
+    }
+    for (auto &tile : m_tiles)
+        tile = SDL_SwapLE16(tile);
+
+    m_tileset.reset(engine->createSprite(tileset_path));
+    return m_tileset != nullptr;
+}
+
+void TileMap::Draw(float camera_x, float camera_y, int frame, int zoom, int view_width, int view_height) {
+    if (!m_tileset)
+        return;
+    const int tile_screen_size = m_tileSize * zoom;
+    const int first_column = SDL_max(0, int(floorf(camera_x / tile_screen_size)));
+    const int last_column = SDL_min(m_columns - 1, int(floorf((camera_x + view_width - 1) / tile_screen_size)));
+    const int first_row = SDL_max(0, int(floorf(camera_y / tile_screen_size)));
+    const int last_row = SDL_min(m_rows - 1, int(floorf((camera_y + view_height - 1) / tile_screen_size)));
+    const int shift_x = -int(roundf(camera_x));
+    const int shift_y = -int(roundf(camera_y));
+
+    const Uint16 *tiles = m_tiles.data() + size_t(frame % m_frames) * m_rows * m_columns;
+    for (int row = first_row; row <= last_row; row++) {
+        for (int column = first_column; column <= last_column; column++) {
+            Uint16 tile = tiles[row * m_columns + column];
+            m_tileset->draw(column * tile_screen_size + shift_x, row * tile_screen_size + shift_y,
+                            tile_screen_size, tile_screen_size,
+                            (tile % m_tilesetColumns) * m_tileSize, (tile / m_tilesetColumns) * m_tileSize,
+                            m_tileSize, m_tileSize);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef CONTRA_TILE_MAP_H
+#define CONTRA_TILE_MAP_H
+
+#include <SDL.h>
+#include <memory>
+#include <vector>
+
+class AvancezLib;
+
+class Sprite;
+
+/**
+ * A background split in square tiles, where identical tiles are stored only once in a small tileset.
+ * The map can hold several frames (e.g. the animated water) which are just alternative tile indices
+ * for the same cells. Only the tiles intersecting the view are drawn.
+ *
+ * The .tiles file is produced offline by tools/tile_converter.cpp, all values are little endian:
+ * magic "CTLM", u16 version, u16 tile size, u16 columns, u16 rows, u16 frames, u16 tileset columns,
+ * u32 width and u32 height of the source image and then frames * rows * columns u16 tile indices.
+ */
+class TileMap {
+public:
+    static constexpr const char *MAGIC = "CTLM";
+    static constexpr Uint16 VERSION = 1;
+
+    TileMap();
+
+    ~TileMap();
+
+    /**
+     * Loads the tile indices and the tileset texture
+     * @return True on success, in case of error the background should be loaded as a plain image
+     */
+    bool Load(AvancezLib *engine, const char *map_path, const char *tileset_path);
+
+    /**
+     * Draws the tiles of the given frame which are visible through the view
+     * @param camera_x Left side of the view, in screen pixels
+     * @param camera_y Top side of the view, in screen pixels
+     * @param zoom Screen pixels per tile pixel
+     */
+    void Draw(float camera_x, float camera_y, int frame, int zoom, int view_width, int view_height);
+
+    /**
+     * @return The width of the source image in pixels
+     */
+    [[nodiscard]] int GetWidth() const {
+        return m_width;
+    }
+
+    [[nodiscard]] int GetHeight() const {
+        return m_height;
+    }
+
+    [[nodiscard]] int GetFrames() const {
+        return m_frames;
+    }
+
+private:
+    std::unique_ptr<Sprite> m_tileset;
+    std::vector<Uint16> m_tiles;
+    int m_tileSize = 0;
+    int m_columns = 0;
+    int m_rows = 0;
+    int m_frames = 0;
+    int m_tilesetColumns = 0;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+#endif //CONTRA_TILE_MAP_H
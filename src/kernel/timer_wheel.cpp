@@ -0,0 +1,188 @@
+#include "timer_wheel.h"
+#include <cmath>
+
+TimerWheel::TimerWheel() {
+    for (int i = 0; i < LEVELS * SLOTS; i++)
+        m_heads[i] = m_tails[i] = -1;
+}
+
+TimerHandle TimerWheel::Schedule(float delay, TimerCallback callback) {
+    return Add(delay, std::move(callback), nullptr, GAME_OVER);
+}
+
+TimerHandle TimerWheel::Schedule(float delay, GameObject *receiver, Message message) {
+    return Add(delay, nullptr, receiver, message);
+}
+
+bool TimerWheel::Cancel(TimerHandle &handle) {
+    if (!IsPending(handle))
+        return false;
+    Unlink(handle.m_index);
+    Release(handle.m_index);
+    handle = TimerHandle();
+    return true;
+}
+
+bool TimerWheel::Reschedule(const TimerHandle &handle, float delay) {
+    if (!IsPending(handle))
+        return false;
+    Unlink(handle.m_index);
+    Timer &timer = m_timers[handle.m_index];
+    timer.deadline = DeadlineAfter(delay);
+    timer.sequence = m_nextSequence++;
+    Insert(handle.m_index);
+    return true;
+}
+
+bool TimerWheel::IsPending(const TimerHandle &handle) const {
+    return Find(handle) != nullptr;
+}
+
+float TimerWheel::GetRemaining(const TimerHandle &handle) const {
+    const Timer *timer = Find(handle);
+    if (timer == nullptr)
+        return 0.f;
+    return float(timer->deadline - m_tick) / TICKS_PER_SECOND;
+}
+
+void TimerWheel::Advance(float dt) {
+    m_time += dt;
+    auto target = uint64_t(m_time * TICKS_PER_SECOND);
+    while (m_tick < target) {
+        m_tick++;
+        ProcessTick();
+    }
+}
+
+void TimerWheel::Clear() {
+    for (int i = 0; i < int(m_timers.size()); i++) {
+        if (m_timers[i].slot >= 0) {
+            Unlink(i);
+            Release(i);
+        }
+    }
+}
+
+TimerHandle TimerWheel::Add(float delay, TimerCallback callback, GameObject *receiver, Message message) {
+    int index;
+    if (m_free.empty()) {
+        index = int(m_timers.size());
+        m_timers.emplace_back();
+    } else {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    Timer &timer = m_timers[index];
+    timer.deadline = DeadlineAfter(delay);
+    timer.sequence = m_nextSequence++;
+    timer.callback = std::move(callback);
+    timer.receiver = receiver;
+    timer.message = message;
+    Insert(index);
+    m_pending++;
+    return TimerHandle(index, timer.generation);
+}
+
+uint64_t TimerWheel::DeadlineAfter(float delay) const {
+    // At least the next tick, the current one has already been processed
+    double ticks = ceil(double(delay) * TICKS_PER_SECOND);
+    return m_tick + (ticks < 1. ? 1 : uint64_t(ticks));
+}
+
+void TimerWheel::Insert(int index) {
+    Timer &timer = m_timers[index];
+    uint64_t delta = timer.deadline - m_tick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1))))
+        level++;
+    uint64_t when = timer.deadline;
+    const uint64_t max_delta = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+    if (delta > max_delta)
+        when = m_tick + max_delta; // Goes around the last wheel until it gets close enough
+    int slot = level * SLOTS + int((when >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    timer.slot = slot;
+    // Timers cascaded from the coarser wheels can be older than the ones already in the slot
+    int previous = m_tails[slot];
+    if (level == 0) {
+        while (previous >= 0 && m_timers[previous].sequence > timer.sequence)
+            previous = m_timers[previous].previous;
+    }
+    int next = previous >= 0 ? m_timers[previous].next : m_heads[slot];
+    timer.previous = previous;
+    timer.next = next;
+    if (previous >= 0)
+        m_timers[previous].next = index;
+    else
+        m_heads[slot] = index;
+    if (next >= 0)
+        m_timers[next].previous = index;
+    else
+        m_tails[slot] = index;
+}
+
+void TimerWheel::Unlink(int index) {
+    Timer &timer = m_timers[index];
+    if (timer.previous >= 0)
+        m_timers[timer.previous].next = timer.next;
+    else
+        m_heads[timer.slot] = timer.next;
+    if (timer.next >= 0)
+        m_timers[timer.next].previous = timer.previous;
+    else
+        m_tails[timer.slot] = timer.previous;
+    timer.previous = timer.next = -1;
+}
+
+void TimerWheel::Release(int index) {
+    Timer &timer = m_timers[index];
+    timer.slot = -1;
+    timer.callback = nullptr;
+    timer.receiver = nullptr;
+    // Invalidates the handles to it, 0 is never a valid generation
+    if (++timer.generation == 0)
+        timer.generation = 1;
+    m_free.push_back(index);
+    m_pending--;
+}
+
+void TimerWheel::ProcessTick() {
+    // Each time a wheel goes around, the next slot of the coarser one is spread over the finer ones
+    for (int level = 1; level < LEVELS; level++) {
+        if ((m_tick & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0)
+            break;
+        int slot = level * SLOTS + int((m_tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+        int index = m_heads[slot];
+        m_heads[slot] = m_tails[slot] = -1;
+        while (index >= 0) {
+            int next = m_timers[index].next;
+            Insert(index);
+            index = next;
+        }
+    }
+
+    int slot = int(m_tick & (SLOTS - 1));
+    int index;
+    while ((index = m_heads[slot]) >= 0) {
+        Unlink(index);
+        Timer &timer = m_timers[index];
+        // The callback can schedule new timers, moving the others in memory
+        TimerCallback callback = std::move(timer.callback);
+        GameObject *receiver = timer.receiver;
+        Message message = timer.message;
+        Release(index);
+        if (receiver)
+            receiver->Receive(message);
+        else if (callback)
+            callback();
+    }
+}
+
+const TimerWheel::Timer *TimerWheel::Find(const TimerHandle &handle) const {
+    if (handle.m_index < 0 || handle.m_index >= int(m_timers.size()))
+        return nullptr;
+    const Timer &timer = m_timers[handle.m_index];
+    if (timer.slot < 0 || timer.generation != handle.m_generation)
+        return nullptr;
+    return &timer;
+}
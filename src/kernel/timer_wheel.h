@@ -0,0 +1,121 @@
+#ifndef CONTRA_TIMER_WHEEL_H
+#define CONTRA_TIMER_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "game_object.h"
+
+typedef std::function<void()> TimerCallback;
+
+/** Refers to a timer of a TimerWheel, it is no longer valid once the timer fires or is cancelled */
+class TimerHandle {
+public:
+    TimerHandle() = default;
+
+private:
+    friend class TimerWheel;
+
+    TimerHandle(int index, unsigned int generation) : m_index(index), m_generation(generation) {}
+
+    int m_index = -1;
+    unsigned int m_generation = 0;
+};
+
+/**
+ * Fires callbacks, or sends messages, once their delay has elapsed, so whatever waits for them does not
+ * have to count down every frame.
+ *
+ * The time is split in ticks of 1ms and the timers are kept in a hierarchical wheel: the ones due in the
+ * next 64 ticks in the slot of their tick, the ones further away in coarser wheels, moved down to the
+ * finer ones as their time gets close. Scheduling, cancelling and advancing a tick are O(1) whatever the
+ * number of timers, and the timers are reused, so they do not allocate once warm (the callbacks may, if
+ * they capture more than a couple of pointers).
+ *
+ * The timers due in the same tick fire in the order they were scheduled (or rescheduled) and the ticks
+ * only depend on the sum of the times advanced, so replaying the same frames fires the same timers in
+ * the same frames and order.
+ */
+class TimerWheel {
+public:
+    static const int TICKS_PER_SECOND = 1000;
+
+    TimerWheel();
+
+    /**
+     * @param delay Seconds until the callback is called, rounded up to the next tick
+     */
+    TimerHandle Schedule(float delay, TimerCallback callback);
+
+    /** Sends the message to the receiver, which must outlive the timer, once the delay has elapsed */
+    TimerHandle Schedule(float delay, GameObject *receiver, Message message);
+
+    /**
+     * Cancels the timer if it has not fired yet, the handle is cleared
+     * @return False if it was not pending
+     */
+    bool Cancel(TimerHandle &handle);
+
+    /**
+     * Fires the timer the delay from now instead of when it was due
+     * @return False if it was not pending
+     */
+    bool Reschedule(const TimerHandle &handle, float delay);
+
+    [[nodiscard]] bool IsPending(const TimerHandle &handle) const;
+
+    /** @return Seconds until the timer fires, 0 if it is not pending */
+    [[nodiscard]] float GetRemaining(const TimerHandle &handle) const;
+
+    /** Moves the time forward, firing the timers due meanwhile, tick by tick */
+    void Advance(float dt);
+
+    /** Cancels all the timers */
+    void Clear();
+
+    [[nodiscard]] int CountPending() const {
+        return m_pending;
+    }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4; // 64 ticks, 4s, 4min and 4.6h
+
+    struct Timer {
+        uint64_t deadline = 0; // Tick
+        uint64_t sequence = 0; // Order of scheduling
+        TimerCallback callback;
+        GameObject *receiver = nullptr;
+        Message message = GAME_OVER;
+        unsigned int generation = 1;
+        int slot = -1; // Of all the levels, -1 if free
+        int previous = -1, next = -1; // In the slot
+    };
+
+    TimerHandle Add(float delay, TimerCallback callback, GameObject *receiver, Message message);
+
+    uint64_t DeadlineAfter(float delay) const;
+
+    // Puts the timer in the slot of its deadline, the ones of the first level sorted by sequence
+    void Insert(int index);
+
+    void Unlink(int index);
+
+    void Release(int index);
+
+    // Cascades the coarser slots due and fires the timers of the tick
+    void ProcessTick();
+
+    const Timer *Find(const TimerHandle &handle) const;
+
+    std::vector<Timer> m_timers;
+    std::vector<int> m_free;
+    int m_heads[LEVELS * SLOTS], m_tails[LEVELS * SLOTS]; // -1 if empty
+    uint64_t m_tick = 0;
+    double m_time = 0.; // Seconds advanced, not rounded to ticks
+    uint64_t m_nextSequence = 0;
+    int m_pending = 0;
+};
+
+#endif //CONTRA_TIMER_WHEEL_H
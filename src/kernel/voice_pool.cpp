@@ -0,0 +1,96 @@
+#include "voice_pool.h"
+
+static VoicePool *finishedPool = nullptr;
+
+void VoicePool::ChannelFinished(int channel) {
+    // Runs in the mixer thread (or inside Mix_HaltChannel), it must not allocate nor lock
+    if (finishedPool && channel >= 0 && channel < finishedPool->count)
+        finishedPool->active[channel].store(false, std::memory_order_release);
+}
+
+void VoicePool::Create(int num_voices) {
+    count = SDL_max(1, SDL_min(num_voices, MAX_VOICES));
+    Mix_AllocateChannels(count);
+    for (int i = 0; i < count; i++) {
+        voices[i] = Voice();
+        active[i].store(false);
+    }
+    finishedPool = this;
+    Mix_ChannelFinished(ChannelFinished);
+}
+
+void VoicePool::Destroy() {
+    Mix_HaltChannel(-1);
+    Mix_ChannelFinished(nullptr);
+    finishedPool = nullptr;
+    count = 0;
+}
+
+SoundHandle VoicePool::Play(const void *owner, Mix_Chunk *chunk, int times, int max_instances, int priority) {
+    if (count == 0 || chunk == nullptr)
+        return {};
+
+    int instances = 0, oldest_instance = -1;
+    int free_voice = -1, victim = -1;
+    for (int i = 0; i < count; i++) {
+        const Voice &voice = voices[i];
+        if (!IsActive(i)) {
+            if (free_voice < 0)
+                free_voice = i;
+            continue;
+        }
+        if (voice.owner == owner) {
+            // Identical trigger in the same frame, it would only make the sound louder
+            if (voice.startFrame == frame)
+                return {i, voice.generation};
+            instances++;
+            if (oldest_instance < 0 || voice.startOrder < voices[oldest_instance].startOrder)
+                oldest_instance = i;
+        }
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.startOrder < voices[victim].startOrder))
+            victim = i;
+    }
+
+    if (max_instances > 0 && instances >= max_instances)
+        return Start(oldest_instance, owner, chunk, times, priority);
+    if (free_voice >= 0)
+        return Start(free_voice, owner, chunk, times, priority);
+    if (victim >= 0 && voices[victim].priority <= priority)
+        return Start(victim, owner, chunk, times, priority);
+    return {};
+}
+
+SoundHandle VoicePool::Start(int channel, const void *owner, Mix_Chunk *chunk, int times, int priority) {
+    if (IsActive(channel))
+        Mix_HaltChannel(channel);
+    Voice &voice = voices[channel];
+    voice.owner = owner;
+    voice.priority = priority;
+    voice.generation++;
+    voice.startFrame = frame;
+    voice.startOrder = order++;
+    active[channel].store(true, std::memory_order_release);
+    if (Mix_PlayChannel(channel, chunk, times - 1) < 0) {
+        active[channel].store(false, std::memory_order_release);
+        return {};
+    }
+    return {channel, voice.generation};
+}
+
+void VoicePool::Stop(SoundHandle handle) {
+    if (IsPlaying(handle))
+        Mix_HaltChannel(handle.channel);
+}
+
+void VoicePool::StopAll(const void *owner) {
+    for (int i = 0; i < count; i++) {
+        if (voices[i].owner == owner && IsActive(i))
+            Mix_HaltChannel(i);
+    }
+}
+
+bool VoicePool::IsPlaying(SoundHandle handle) const {
+    return handle.channel >= 0 && handle.channel < count && IsActive(handle.channel) &&
+           voices[handle.channel].generation == handle.generation;
+}
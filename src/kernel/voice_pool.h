@@ -0,0 +1,77 @@
+#ifndef CONTRA_VOICE_POOL_H
+#define CONTRA_VOICE_POOL_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <atomic>
+
+/**
+ * Identifies one play of a sound. It stays valid to stop it until the voice is reused,
+ * after that stopping it does nothing.
+ */
+struct SoundHandle {
+    int channel = -1;
+    Uint32 generation = 0;
+};
+
+/**
+ * Fixed set of mixer channels (voices) shared by all the sound effects. When a sound is played:
+ * - If the same sound was already triggered this frame, that voice is reused and nothing new plays.
+ * - If the sound already plays its max instances, its oldest voice is restarted.
+ * - Otherwise a free voice is used or, if there is none, the oldest voice of the lowest priority is
+ *   stolen, as long as that priority is not above the one of the new sound (else it is dropped).
+ * Everything happens on the main thread, the mixer callback only clears a flag.
+ */
+class VoicePool {
+public:
+    static const int MAX_VOICES = 32;
+
+    /** Allocates the mixer channels, must be called once the audio is open */
+    void Create(int num_voices);
+
+    void Destroy();
+
+    /** Starts a new frame for the same frame deduplication */
+    void BeginFrame() {
+        frame++;
+    }
+
+    /**
+     * @param owner Identifies the sound for the instance limit and the deduplication
+     * @param times Times to play the chunk, 0 loops forever
+     */
+    SoundHandle Play(const void *owner, Mix_Chunk *chunk, int times, int max_instances, int priority);
+
+    void Stop(SoundHandle handle);
+
+    // Stops all the voices of the owner, i.e. before freeing its chunk
+    void StopAll(const void *owner);
+
+    [[nodiscard]] bool IsPlaying(SoundHandle handle) const;
+
+private:
+    struct Voice {
+        const void *owner = nullptr;
+        int priority = 0;
+        Uint32 generation = 0;
+        Uint64 startFrame = 0;
+        Uint64 startOrder = 0; // To find the oldest voice
+    };
+
+    static void ChannelFinished(int channel);
+
+    [[nodiscard]] bool IsActive(int channel) const {
+        return active[channel].load(std::memory_order_acquire);
+    }
+
+    SoundHandle Start(int channel, const void *owner, Mix_Chunk *chunk, int times, int priority);
+
+    Voice voices[MAX_VOICES];
+    // Cleared by the mixer thread when the channel finishes
+    std::atomic<bool> active[MAX_VOICES] = {};
+    int count = 0;
+    Uint64 frame = 1;
+    Uint64 order = 0;
+};
+
+#endif //CONTRA_VOICE_POOL_H
@@ -0,0 +1,132 @@
+/**
+ * Build-time packer which combines sprite sheets into as few atlas pages as possible and writes the
+ * remap table loaded by AvancezLib::loadAtlas.
+ *
+ * Usage: AtlasPacker <output prefix> <max page size> <image>...
+ *
+ * Every image is packed whole, so the coordinates used inside a sprite sheet are translated to the
+ * atlas by just adding the offset of its rect. The table is a text file (<output prefix>.atlas):
+ *   page <path of the page image>
+ *   sprite <source path> <page index> <x> <y> <w> <h>
+ */
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+const int PADDING = 1; // Empty pixels around each image
+
+struct Source {
+    std::string path;
+    SDL_Surface *surface;
+    int page;
+    SDL_Rect rect;
+};
+
+int main(int argc, char *argv[]) {
+    if (argc < 4) {
+        SDL_Log("Usage: %s <output prefix> <max page size> <image>...", argv[0]);
+        return 1;
+    }
+    const std::string output = argv[1];
+    const int max_size = atoi(argv[2]);
+
+    IMG_Init(IMG_INIT_PNG);
+    std::vector<Source> sources;
+    long area = 0;
+    int max_width = 0;
+    for (int i = 3; i < argc; i++) {
+        SDL_Surface *loaded = IMG_Load(argv[i]);
+        if (loaded == nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s! SDL_image Error: %s", argv[i],
+                         IMG_GetError());
+            return 1;
+        }
+        SDL_Surface *surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (surface->w + 2 * PADDING > max_size || surface->h + 2 * PADDING > max_size) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s does not fit in a %dx%d page", argv[i], max_size,
+                         max_size);
+            return 1;
+        }
+        area += long(surface->w + 2 * PADDING) * (surface->h + 2 * PADDING);
+        max_width = std::max(max_width, surface->w + 2 * PADDING);
+        sources.push_back({argv[i], surface, 0, {0, 0, surface->w, surface->h}});
+    }
+
+    // Shelf packing, tallest first, in pages as wide as the smallest power of two fitting everything
+    int page_width = 1;
+    while (page_width < max_width || page_width * page_width < area)
+        page_width *= 2;
+    page_width = std::min(page_width, max_size);
+
+    std::vector<Source *> sorted;
+    for (auto &source : sources)
+        sorted.push_back(&source);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Source *a, const Source *b) {
+        return a->surface->h > b->surface->h;
+    });
+
+    std::vector<int> page_heights = {0};
+    int shelf_x = 0, shelf_y = 0, shelf_height = 0;
+    for (auto *source : sorted) {
+        const int w = source->surface->w + 2 * PADDING;
+        const int h = source->surface->h + 2 * PADDING;
+        if (shelf_x + w > page_width) {
+            shelf_y += shelf_height;
+            shelf_x = 0;
+            shelf_height = 0;
+        }
+        if (shelf_y + h > max_size) {
+            page_heights.push_back(0);
+            shelf_x = shelf_y = shelf_height = 0;
+        }
+        source->page = int(page_heights.size()) - 1;
+        source->rect.x = shelf_x + PADDING;
+        source->rect.y = shelf_y + PADDING;
+        shelf_x += w;
+        shelf_height = std::max(shelf_height, h);
+        page_heights.back() = std::max(page_heights.back(), shelf_y + h);
+    }
+
+    const std::string table_path = output + ".atlas";
+    SDL_RWops *table = SDL_RWFromFile(table_path.c_str(), "w");
+    if (table == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to write %s: %s", table_path.c_str(), SDL_GetError());
+        return 1;
+    }
+    for (int page = 0; page < (int) page_heights.size(); page++) {
+        SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, page_width, page_heights[page], 32,
+                                                            SDL_PIXELFORMAT_RGBA32);
+        SDL_FillRect(atlas, nullptr, 0);
+        for (auto &source : sources) {
+            if (source.page != page)
+                continue;
+            // Copy the pixels as they are, alpha included
+            SDL_SetSurfaceBlendMode(source.surface, SDL_BLENDMODE_NONE);
+            SDL_Rect dst = source.rect;
+            SDL_BlitSurface(source.surface, nullptr, atlas, &dst);
+        }
+        const std::string page_path = output + "_" + std::to_string(page) + ".png";
+        if (IMG_SavePNG(atlas, page_path.c_str()) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to save %s: %s", page_path.c_str(), IMG_GetError());
+            return 1;
+        }
+        SDL_FreeSurface(atlas);
+        const std::string line = "page " + page_path + "\n";
+        SDL_RWwrite(table, line.data(), 1, line.size());
+        SDL_Log("%s: %dx%d", page_path.c_str(), page_width, page_heights[page]);
+    }
+    for (auto &source : sources) {
+        const std::string line = "sprite " + source.path + " " + std::to_string(source.page) + " " +
+                                 std::to_string(source.rect.x) + " " + std::to_string(source.rect.y) + " " +
+                                 std::to_string(source.rect.w) + " " + std::to_string(source.rect.h) + "\n";
+        SDL_RWwrite(table, line.data(), 1, line.size());
+        SDL_FreeSurface(source.surface);
+    }
+    SDL_RWclose(table);
+    IMG_Quit();
+    return 0;
+}
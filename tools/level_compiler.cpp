@@ -0,0 +1,70 @@
+/**
+ * Build-time compiler which validates the level.yaml of each level folder against the level schema
+ * and writes the compiled level.bin next to it, loaded by LevelData without parsing any YAML.
+ *
+ * Usage: LevelCompiler <level folder>...
+ *
+ * Fails without writing anything for a folder if its level has errors, all of them are reported.
+ */
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include "../src/contra/level/level_data.h"
+
+static bool CompileFolder(std::string folder) {
+    if (folder.back() != '/')
+        folder += '/';
+    const std::string source_path = folder + "level.yaml";
+
+    SDL_RWops *source_file = SDL_RWFromFile(source_path.c_str(), "rb");
+    if (source_file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not open %s: %s", source_path.c_str(), SDL_GetError());
+        return false;
+    }
+    std::string source(size_t(SDL_max(Sint64(0), SDL_RWsize(source_file))), '\0');
+    bool read = source.empty() || SDL_RWread(source_file, &source[0], source.size(), 1) == 1;
+    SDL_RWclose(source_file);
+    if (!read) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not read %s", source_path.c_str());
+        return false;
+    }
+
+    LevelData data;
+    std::vector<std::string> errors;
+    try {
+        data.Compile(YAML::Load(source), LevelData::HashSource(source.data(), source.size()), errors);
+    } catch (const YAML::Exception &e) {
+        errors.emplace_back(e.what());
+    }
+    for (const auto &error : errors)
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: %s", source_path.c_str(), error.c_str());
+    if (!errors.empty())
+        return false;
+
+    const std::string output_path = folder + "level.bin";
+    SDL_RWops *file = SDL_RWFromFile(output_path.c_str(), "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write %s: %s", output_path.c_str(), SDL_GetError());
+        return false;
+    }
+    const std::vector<Uint8> &bytes = data.GetBytes();
+    bool written = SDL_RWwrite(file, bytes.data(), bytes.size(), 1) == 1;
+    SDL_RWclose(file);
+    if (!written) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not write %s", output_path.c_str());
+        return false;
+    }
+    SDL_Log("%s: %d bytes", output_path.c_str(), (int) bytes.size());
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        SDL_Log("Usage: %s <level folder>...", argv[0]);
+        return 1;
+    }
+    bool ok = true;
+    for (int i = 1; i < argc; i++)
+        ok = CompileFolder(argv[i]) && ok;
+    return ok ? 0 : 1;
+}
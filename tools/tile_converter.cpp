@@ -0,0 +1,177 @@
+/**
+ * Offline converter which slices the background of a level into NES-like tiles, deduplicates them
+ * into a small tileset image and writes the tile index map read by TileMap.
+ *
+ * Usage: TileConverter <level folder> [tile size (8 or 16), 16 by default]
+ *
+ * The level.yaml of the folder has to define background_tiles, the name (without extension) of the
+ * files to generate. If background_animation_shift is defined, the shifted area of the background
+ * is converted as a second frame of the same map, so the animation is just a swap of tile indices.
+ */
+#include <SDL.h>
+#include <SDL_image.h>
+#include <yaml-cpp/yaml.h>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../src/kernel/tile_map.h"
+
+const int TILESET_COLUMNS = 32;
+
+// FNV-1a, only used to find the candidates to compare against
+static Uint64 HashTile(const Uint32 *pixels, int count) {
+    Uint64 hash = 14695981039346656037ULL;
+    const auto *bytes = (const Uint8 *) pixels;
+    for (int i = 0; i < count * 4; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Copies a tile of the surface, pixels outside of the frame rect are transparent black
+static void ReadTile(SDL_Surface *surface, const SDL_Rect &frame, int x, int y, int tile_size, Uint32 *out) {
+    for (int j = 0; j < tile_size; j++) {
+        for (int i = 0; i < tile_size; i++) {
+            Uint32 pixel = 0;
+            if (x + i < frame.w && y + j < frame.h) {
+                const auto *row = (const Uint8 *) surface->pixels + (frame.y + y + j) * surface->pitch;
+                memcpy(&pixel, row + (frame.x + x + i) * 4, 4);
+            }
+            out[j * tile_size + i] = pixel;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        SDL_Log("Usage: %s <level folder> [tile size]", argv[0]);
+        return 1;
+    }
+    std::string folder = argv[1];
+    if (folder.back() != '/')
+        folder += '/';
+    const int tile_size = argc > 2 ? atoi(argv[2]) : 16;
+    if (tile_size != 8 && tile_size != 16) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tile size must be 8 or 16");
+        return 1;
+    }
+
+    YAML::Node root;
+    try {
+        root = YAML::LoadFile(folder + "level.yaml");
+    } catch (const YAML::Exception &e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Could not read %slevel.yaml: %s", folder.c_str(), e.what());
+        return 1;
+    }
+    if (!root["background_tiles"]) {
+        SDL_Log("%slevel.yaml does not define background_tiles, nothing to convert", folder.c_str());
+        return 0;
+    }
+    const std::string background_path = folder + root["background"].as<std::string>();
+    const std::string output = folder + root["background_tiles"].as<std::string>();
+    int shift_x = 0, shift_y = 0;
+    if (root["background_animation_shift"]) {
+        shift_x = root["background_animation_shift"][0].as<int>();
+        shift_y = root["background_animation_shift"][1].as<int>();
+    }
+
+    IMG_Init(IMG_INIT_PNG);
+    SDL_Surface *loaded = IMG_Load(background_path.c_str());
+    if (loaded == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to load image %s! SDL_image Error: %s",
+                     background_path.c_str(), IMG_GetError());
+        return 1;
+    }
+    SDL_Surface *image = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    SDL_LockSurface(image);
+
+    const int frames = (shift_x != 0 || shift_y != 0) ? 2 : 1;
+    const int width = image->w - shift_x;
+    const int height = image->h - shift_y;
+    const int columns = (width + tile_size - 1) / tile_size;
+    const int rows = (height + tile_size - 1) / tile_size;
+    const int tile_pixels = tile_size * tile_size;
+
+    std::vector<Uint16> map;
+    std::vector<Uint32> tileset;
+    std::unordered_map<Uint64, std::vector<Uint16>> tiles_by_hash;
+    std::vector<Uint32> tile(tile_pixels);
+    for (int frame = 0; frame < frames; frame++) {
+        const SDL_Rect frame_rect = {frame * shift_x, frame * shift_y, width, height};
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < columns; column++) {
+                ReadTile(image, frame_rect, column * tile_size, row * tile_size, tile_size, tile.data());
+                auto &candidates = tiles_by_hash[HashTile(tile.data(), tile_pixels)];
+                int index = -1;
+                for (Uint16 candidate : candidates) {
+                    if (memcmp(&tileset[candidate * tile_pixels], tile.data(), tile_pixels * 4) == 0) {
+                        index = candidate;
+                        break;
+                    }
+                }
+                if (index < 0) {
+                    index = int(tileset.size() / tile_pixels);
+                    if (index > 0xFFFF) {
+                        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Too many different tiles in %s",
+                                     background_path.c_str());
+                        return 1;
+                    }
+                    tileset.insert(tileset.end(), tile.begin(), tile.end());
+                    candidates.push_back(index);
+                }
+                map.push_back(index);
+            }
+        }
+    }
+    SDL_UnlockSurface(image);
+    SDL_FreeSurface(image);
+
+    const int tile_count = int(tileset.size() / tile_pixels);
+    const int tileset_rows = (tile_count + TILESET_COLUMNS - 1) / TILESET_COLUMNS;
+    SDL_Surface *tileset_image = SDL_CreateRGBSurfaceWithFormat(0, TILESET_COLUMNS * tile_size,
+                                                                tileset_rows * tile_size, 32,
+                                                                SDL_PIXELFORMAT_RGBA32);
+    SDL_FillRect(tileset_image, nullptr, 0);
+    for (int t = 0; t < tile_count; t++) {
+        const int x = (t % TILESET_COLUMNS) * tile_size;
+        const int y = (t / TILESET_COLUMNS) * tile_size;
+        for (int j = 0; j < tile_size; j++) {
+            auto *row = (Uint8 *) tileset_image->pixels + (y + j) * tileset_image->pitch;
+            memcpy(row + x * 4, &tileset[t * tile_pixels + j * tile_size], tile_size * 4);
+        }
+    }
+    const std::string tileset_path = output + ".png";
+    if (IMG_SavePNG(tileset_image, tileset_path.c_str()) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to save %s: %s", tileset_path.c_str(), IMG_GetError());
+        return 1;
+    }
+    SDL_FreeSurface(tileset_image);
+
+    const std::string map_path = output + ".tiles";
+    SDL_RWops *file = SDL_RWFromFile(map_path.c_str(), "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to write %s: %s", map_path.c_str(), SDL_GetError());
+        return 1;
+    }
+    SDL_RWwrite(file, TileMap::MAGIC, 1, 4);
+    SDL_WriteLE16(file, TileMap::VERSION);
+    SDL_WriteLE16(file, tile_size);
+    SDL_WriteLE16(file, columns);
+    SDL_WriteLE16(file, rows);
+    SDL_WriteLE16(file, frames);
+    SDL_WriteLE16(file, TILESET_COLUMNS);
+    SDL_WriteLE32(file, width);
+    SDL_WriteLE32(file, height);
+    for (Uint16 index : map)
+        SDL_WriteLE16(file, index);
+    SDL_RWclose(file);
+
+    SDL_Log("%s: %d cells in %d frames, %d unique %dx%d tiles (%dx%d tileset)", background_path.c_str(),
+            columns * rows, frames, tile_count, tile_size, tile_size, TILESET_COLUMNS * tile_size,
+            tileset_rows * tile_size);
+    IMG_Quit();
+    return 0;
+}